@@ -0,0 +1,156 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+
+/*
+	Represents bounded lock-free queue for many producers and many
+	consumers, every slot carries sequence number that tells whether
+	it's ready for writing or reading in the current lap
+*/
+template <typename T>
+class BoundedQueue
+{
+public:
+	/*
+		Creates queue, the capacity is rounded up to power of two
+
+		@param capacity Minimal count of items
+	*/
+	BoundedQueue(size_t capacity)
+	{
+		size_t size = 2;
+
+		while (size < capacity)
+		{
+			size *= 2;
+		}
+
+		slots_.reset(new slot[size]);
+		mask_ = size - 1;
+
+		for (size_t i = 0; i < size; i++)
+		{
+			slots_[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		head_.store(0, std::memory_order_relaxed);
+		tail_.store(0, std::memory_order_relaxed);
+	}
+
+	/*
+		Pushes item if there is free slot
+
+		@param item Pushed item
+		@return if the item was pushed
+	*/
+	bool tryPush(const T& item)
+	{
+		size_t position = tail_.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			slot& target = slots_[position & mask_];
+			size_t sequence = target.sequence.load(std::memory_order_acquire);
+			std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+			if (difference == 0)
+			{
+				if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					target.item = item;
+					target.sequence.store(position + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (difference < 0)
+			{
+				return false;
+			}
+			else
+			{
+				position = tail_.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	/*
+		Pops item if there is any
+
+		@param item Popped item
+		@return if the item was popped
+	*/
+	bool tryPop(T& item)
+	{
+		size_t position = head_.load(std::memory_order_relaxed);
+
+		while (true)
+		{
+			slot& source = slots_[position & mask_];
+			size_t sequence = source.sequence.load(std::memory_order_acquire);
+			std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+			if (difference == 0)
+			{
+				if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					item = source.item;
+					source.sequence.store(position + mask_ + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (difference < 0)
+			{
+				return false;
+			}
+			else
+			{
+				position = head_.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	/*
+		Get approximate count of items, it's exact only when
+		nobody pushes or pops
+
+		@return count of items
+	*/
+	size_t getSize() const
+	{
+		size_t tail = tail_.load(std::memory_order_relaxed);
+		size_t head = head_.load(std::memory_order_relaxed);
+
+		return tail > head ? tail - head : 0;
+	}
+
+	/*
+		Get count of slots
+
+		@return capacity of the queue
+	*/
+	size_t getCapacity() const
+	{
+		return mask_ + 1;
+	}
+private:
+	BoundedQueue(const BoundedQueue&);
+	BoundedQueue& operator=(const BoundedQueue&);
+private:
+	// Represents one item with its sequence number
+	struct slot
+	{
+		std::atomic<size_t> sequence;
+		T item;
+	};
+
+	// Represents ring of slots
+	std::unique_ptr<slot[]> slots_;
+	// Represents mask of the position
+	size_t mask_;
+	// Represents position of the next pop, it's apart from tail to avoid false sharing
+	alignas(64) std::atomic<size_t> head_;
+	// Represents position of the next push
+	alignas(64) std::atomic<size_t> tail_;
+};
@@ -0,0 +1,49 @@
+#include "BuiltinPuzzles.h"
+#include "ConstexprSolver.h"
+
+namespace
+{
+	constexpr builtinPuzzle embed(const char* name, const ConstexprSolver::result& solved)
+	{
+		builtinPuzzle puzzle = { name, {}, {} };
+
+		for (int cell = 0; cell < 81; cell++)
+		{
+			puzzle.problem[cell] = solved.problem[cell];
+			puzzle.solution[cell] = solved.solution[cell];
+		}
+
+		return puzzle;
+	}
+
+	// The puzzle that used to be read from text.txt
+	constexpr char CLASSIC[] = ".8....2......84.9...632..1..97....8.8..9.3..2.1....95..7..458...3.71......8....4.";
+	constexpr char NEWSPAPER[] = "53..7....6..195....98....6.8...6...34..8.3..17...2...6.6....28....419..5....8..79";
+	constexpr char EVENING[] = "..3.2.6..9..3.5..1..18.64....81.29..7.......8..67.82....26.95..8..2.3..9..5.1.3..";
+
+	constexpr ConstexprSolver::result CLASSIC_SOLVED = ConstexprSolver::solve(CLASSIC);
+	constexpr ConstexprSolver::result NEWSPAPER_SOLVED = ConstexprSolver::solve(NEWSPAPER);
+	constexpr ConstexprSolver::result EVENING_SOLVED = ConstexprSolver::solve(EVENING);
+
+	static_assert(CLASSIC_SOLVED.valid && CLASSIC_SOLVED.count == 1, "Built-in puzzle has to have unique solution");
+	static_assert(NEWSPAPER_SOLVED.valid && NEWSPAPER_SOLVED.count == 1, "Built-in puzzle has to have unique solution");
+	static_assert(EVENING_SOLVED.valid && EVENING_SOLVED.count == 1, "Built-in puzzle has to have unique solution");
+
+	constexpr builtinPuzzle PUZZLES[] = {
+		embed("classic", CLASSIC_SOLVED),
+		embed("newspaper", NEWSPAPER_SOLVED),
+		embed("evening", EVENING_SOLVED),
+	};
+}
+
+
+int BuiltinPuzzles::getCount()
+{
+	return static_cast<int>(sizeof(PUZZLES) / sizeof(PUZZLES[0]));
+}
+
+
+const builtinPuzzle& BuiltinPuzzles::get(int index)
+{
+	return PUZZLES[index];
+}
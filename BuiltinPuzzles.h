@@ -0,0 +1,39 @@
+#pragma once
+
+
+/*
+	Represents puzzle embedded in the binary with its solution
+*/
+struct builtinPuzzle
+{
+	// Name of the puzzle
+	const char* name;
+	// Problem in row-major order, 0 means empty cell
+	int problem[81];
+	// Unique solution of the problem
+	int solution[81];
+};
+
+
+/*
+	Represents puzzles solved while compiling, launching them
+	needs no file and no search
+*/
+class BuiltinPuzzles
+{
+public:
+	/*
+		Get count of built-in puzzles
+
+		@return count of puzzles
+	*/
+	static int getCount();
+
+	/*
+		Get built-in puzzle
+
+		@param index Index of the puzzle
+		@return puzzle with its solution
+	*/
+	static const builtinPuzzle& get(int index);
+};
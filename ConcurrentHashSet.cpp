@@ -0,0 +1,151 @@
+#include "ConcurrentHashSet.h"
+#include <algorithm>
+
+const std::uint64_t ConcurrentHashSet::EMPTY_KEY = 0;
+
+
+void probeStats::add(const probeStats& other)
+{
+	inserts += other.inserts;
+	duplicates += other.duplicates;
+	collisions += other.collisions;
+	maxProbe = std::max(maxProbe, other.maxProbe);
+}
+
+
+ConcurrentHashSet::ConcurrentHashSet(size_t capacity)
+{
+	size_t size = 2;
+
+	while (size < capacity)
+	{
+		size *= 2;
+	}
+
+	slots_.reset(new std::atomic<std::uint64_t>[size]);
+	mask_ = size - 1;
+
+	for (size_t i = 0; i < size; i++)
+	{
+		slots_[i].store(EMPTY_KEY, std::memory_order_relaxed);
+	}
+
+	size_.store(0, std::memory_order_relaxed);
+	hasEmptyKey_.store(false, std::memory_order_relaxed);
+}
+
+
+ConcurrentHashSet::~ConcurrentHashSet()
+{
+}
+
+
+InsertResult ConcurrentHashSet::insert(std::uint64_t key, probeStats& stats)
+{
+	size_t index = getHome(key);
+	long long probe = 0;
+	InsertResult result = InsertResult::FULL;
+
+	stats.inserts++;
+
+	// Hash 0 would look like free slot, so it has its own flag
+	if (key == EMPTY_KEY)
+	{
+		if (hasEmptyKey_.exchange(true, std::memory_order_acq_rel))
+		{
+			stats.duplicates++;
+			return InsertResult::DUPLICATE;
+		}
+
+		size_.fetch_add(1, std::memory_order_relaxed);
+		return InsertResult::INSERTED;
+	}
+
+	for (; static_cast<size_t>(probe) <= mask_; probe++, index = (index + 1) & mask_)
+	{
+		std::uint64_t stored = slots_[index].load(std::memory_order_acquire);
+
+		if (stored == EMPTY_KEY)
+		{
+			// Other thread may claim the slot first, then its key is checked as usual
+			if (slots_[index].compare_exchange_strong(stored, key, std::memory_order_acq_rel))
+			{
+				size_.fetch_add(1, std::memory_order_relaxed);
+				result = InsertResult::INSERTED;
+				break;
+			}
+		}
+
+		if (stored == key)
+		{
+			stats.duplicates++;
+			result = InsertResult::DUPLICATE;
+			break;
+		}
+	}
+
+	stats.collisions += probe;
+	stats.maxProbe = std::max(stats.maxProbe, probe);
+
+	return result;
+}
+
+
+InsertResult ConcurrentHashSet::insert(std::uint64_t key)
+{
+	probeStats stats;
+	return insert(key, stats);
+}
+
+
+bool ConcurrentHashSet::contains(std::uint64_t key) const
+{
+	if (key == EMPTY_KEY)
+	{
+		return hasEmptyKey_.load(std::memory_order_acquire);
+	}
+
+	size_t index = getHome(key);
+
+	for (size_t probe = 0; probe <= mask_; probe++, index = (index + 1) & mask_)
+	{
+		std::uint64_t stored = slots_[index].load(std::memory_order_acquire);
+
+		if (stored == key)
+		{
+			return true;
+		}
+
+		if (stored == EMPTY_KEY)
+		{
+			return false;
+		}
+	}
+
+	return false;
+}
+
+
+size_t ConcurrentHashSet::getSize() const
+{
+	return size_.load(std::memory_order_relaxed);
+}
+
+
+size_t ConcurrentHashSet::getCapacity() const
+{
+	return mask_ + 1;
+}
+
+
+size_t ConcurrentHashSet::getCapacityFor(size_t count)
+{
+	return count * 2 + 2;
+}
+
+
+size_t ConcurrentHashSet::getHome(std::uint64_t key) const
+{
+	// Fibonacci hashing spreads keys that differ only in high bits
+	return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) & mask_;
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+
+/*
+	Represents result of inserting into the set
+*/
+enum class InsertResult
+{
+	INSERTED, DUPLICATE, FULL
+};
+
+
+/*
+	Represents collision statistics of inserts, every thread
+	keeps its own statistics and they are added up afterwards
+*/
+struct probeStats
+{
+	// Count of inserts
+	long long inserts = 0;
+	// Count of inserts of keys that were already in the set
+	long long duplicates = 0;
+	// Count of occupied slots passed before the key was placed or found
+	long long collisions = 0;
+	// The longest run of passed slots
+	long long maxProbe = 0;
+
+	/*
+		Adds statistics of other thread
+
+		@param other Statistics of other thread
+	*/
+	void add(const probeStats& other);
+};
+
+
+/*
+	Represents lock-free set of 64-bit hashes with fixed capacity,
+	slots are claimed by compare-and-swap with linear probing and
+	keys are never removed, key 0 marks free slot so it's kept
+	apart from slots
+*/
+class ConcurrentHashSet
+{
+public:
+	/*
+		Creates set, the capacity is rounded up to power of two
+
+		@param capacity Minimal count of slots
+	*/
+	ConcurrentHashSet(size_t capacity);
+	~ConcurrentHashSet();
+
+	/*
+		Inserts the key, it's safe to call from many threads
+
+		@param key Hash of the item
+		@param stats Statistics of the calling thread
+		@return INSERTED if the key is new, DUPLICATE if it's already
+			in the set and FULL if there is no free slot
+	*/
+	InsertResult insert(std::uint64_t key, probeStats& stats);
+
+	/*
+		Inserts the key without statistics
+
+		@param key Hash of the item
+		@return Result of the insert
+	*/
+	InsertResult insert(std::uint64_t key);
+
+	/*
+		Checks if the key is in the set
+
+		@param key Hash of the item
+		@return if the key is in the set
+	*/
+	bool contains(std::uint64_t key) const;
+
+	/*
+		Get count of keys
+
+		@return count of keys
+	*/
+	size_t getSize() const;
+
+	/*
+		Get count of slots
+
+		@return count of slots
+	*/
+	size_t getCapacity() const;
+
+	/*
+		Computes smallest capacity that keeps the load factor at most half
+
+		@param count Expected count of keys
+		@return Capacity for the count
+	*/
+	static size_t getCapacityFor(size_t count);
+public:
+	const static std::uint64_t EMPTY_KEY;
+private:
+	/*
+		Get slot where probing of the key starts
+
+		@param key Stored key
+		@return Index of the slot
+	*/
+	size_t getHome(std::uint64_t key) const;
+private:
+	// Represents slots, EMPTY_KEY marks free slot
+	std::unique_ptr<std::atomic<std::uint64_t>[]> slots_;
+	// Represents capacity - 1
+	size_t mask_;
+	// Represents count of keys
+	std::atomic<size_t> size_;
+	// Represents if EMPTY_KEY was inserted
+	std::atomic<bool> hasEmptyKey_;
+};
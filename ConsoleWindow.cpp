@@ -2,26 +2,47 @@
 
 
 ConsoleWindow::ConsoleWindow()
+	: telemetry_(GameWindowSettings::TELEMETRY_FILE)
 {
 	iRows_ = 53;
 	iCols_ = 90;
-	iActualCell_ = 0;
+	watchedState_ = nullptr;
+	memset(highlighted_, 0, sizeof(highlighted_));
 	
 	setSize();
 	disableResize();
 	hideCursor();
 
 	try {
- 		sudoku_ = new Sudoku();
+		PuzzleLibrary library;
+		std::mt19937 random(std::random_device{}());
+		int index = library.open(GameWindowSettings::LIBRARY_FILE) ?
+			library.findRandom(libraryQuery(), random) : -1;
+
+		if (index >= 0)
+		{
+			sudoku_ = new Sudoku(library, index);
+		}
+		else if (std::ifstream(GameWindowSettings::PUZZLE_FILE).good())
+		{
+			sudoku_ = new Sudoku(GameWindowSettings::PUZZLE_FILE);
+		}
+		else
+		{
+			std::uniform_int_distribution<int> builtin(0, BuiltinPuzzles::getCount() - 1);
+			sudoku_ = new Sudoku(BuiltinPuzzles::get(builtin(random)));
+		}
 	}
-	catch (std::exception)
+	catch (const std::exception& e)
 	{
 		printTitle();
 		print();
-		showMessage("Couldn't open file", MessageInfo::ERROR_FILE);
-		exit(1);
+		showMessage(e.what(), MessageInfo::ERROR_FILE);
+		throw;
 	}
 
+	session_ = new GameSession(*sudoku_);
+
 	for (int i = 0; i < 9; i++)
 	{
 		for (int j = 0; j < 9; j++)
@@ -70,72 +91,131 @@ void ConsoleWindow::run()
 {
 	printTitle();
 	print();
+	printGame();
+	printNotesMode();
+	telemetry_.startSession(sudoku_->getHash());
+
+	int problem[81];
+	int solution[81];
+
+	sudoku_->getPuzzle(problem, solution);
+
+	// Recording keeps only numbers, replay of variant puzzle would use classic rules
+	if (sudoku_->getRules().isClassic())
+	{
+		recorder_.start(GameWindowSettings::RECORD_FILE, problem, solution);
+	}
 
 	bool isRunning = true;
 	char c;
 
 	do {
-		printGame();
-
 		if (sudoku_->isGameWon())
 		{
+			// Returning lets destructors end the telemetry session and the recording
 			showMessage("YOU WON!", MessageInfo::WIN_MESSAGE);
+			isRunning = false;
+			continue;
 		}
 
 		c = _getch();
-		switch (c)
+		gameStep step = applyKey(c);
+		recorder_.record(c, session_->getStateHash());
+
+		if (step.action == GameAction::WATCH)
 		{
-		case 'w':
-			iActualCell_ -= 9;
-			iActualCell_ = iActualCell_ < 0 ? iActualCell_ + 9 : iActualCell_;
-			break;
-		case 's':
-			iActualCell_ += 9;
-			iActualCell_ = iActualCell_ >= 81 ? iActualCell_ - 9 : iActualCell_;
-			break;
-		case'd':
-			iActualCell_++;
-			iActualCell_ = iActualCell_ >= 81 ? iActualCell_ - 1 : iActualCell_;
-			break;
-		case 'a':
-			iActualCell_--;
-			iActualCell_ = iActualCell_ < 0 ? iActualCell_ + 1 : iActualCell_;
-			break;
-		case '1':
-		case '2':
-		case '3':
-		case '4':
-		case '5':
-		case '6':
-		case '7':
-		case '8':
-		case '9':
-			SetConsoleCursorPosition(GetStdHandle(STD_OUTPUT_HANDLE),
-				COORD{ (short)(GameWindowSettings::GAME_BOARD_X_POS + cTable[iActualCell_ / 9][iActualCell_ % 9].xPos + GameWindowSettings::CELL_WIDTH / 2),
-					   (short)(GameWindowSettings::GAME_BOARD_Y_POS + cTable[iActualCell_ / 9][iActualCell_ % 9].yPos + GameWindowSettings::CELL_HEIGHT / 2)
-			});
-			if (sudoku_->isNumberEditable(iActualCell_ % 9, iActualCell_ / 9))
+			watchSolving();
+		}
+	} while (isRunning);
+}
+
+
+void ConsoleWindow::replay(const sessionRecording& recording, bool realTime)
+{
+	delete session_;
+	delete sudoku_;
+	sudoku_ = new Sudoku(recording.puzzle);
+	session_ = new GameSession(*sudoku_);
+
+	printTitle();
+	print();
+	printGame();
+	printNotesMode();
+
+	long long mismatches = 0;
+	auto start = std::chrono::steady_clock::now();
+
+	for (size_t i = 0; i < recording.keys.size(); i++)
+	{
+		const recordedKey& key = recording.keys[i];
+
+		if (realTime)
+		{
+			std::this_thread::sleep_for(std::chrono::microseconds(key.delay));
+		}
+
+		gameStep step = applyKey(key.key);
+		size_t watched = 0;
+
+		if (step.action == GameAction::WATCH)
+		{
+			watched = watchSolving(recording.keys.data() + i + 1, recording.keys.size() - i - 1, realTime);
+		}
+
+		// Keys read by watching don't change the game, so they have the same check
+		for (size_t j = i; j <= i + watched; j++)
+		{
+			if (static_cast<std::uint32_t>(session_->getStateHash()) != recording.keys[j].check)
 			{
-				sudoku_->setValue(int(c - '0'), iActualCell_ % 9, iActualCell_ / 9);
-				sudoku_->isValueValid(int(c - '0'), iActualCell_ % 9, iActualCell_ / 9, false);
-				
-				if (!sudoku_->isAnyPositionEmpty() && sudoku_->checkPlayerSolution())
-				{
-					sudoku_->setGameWon(true);
-				}
+				mismatches++;
 			}
-			break;
 		}
-	} while (isRunning);
+
+		i += watched;
+	}
+
+	long long milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::steady_clock::now() - start).count();
+	printStatus("REPLAYED " + std::to_string(recording.keys.size()) + " keys in " + std::to_string(milliseconds) +
+		" ms, " + std::to_string(mismatches) + " mismatches");
 }
 
 
 ConsoleWindow::~ConsoleWindow()
 {
+	delete session_;
 	delete sudoku_;
 }
 
 
+gameStep ConsoleWindow::applyKey(char key)
+{
+	gameStep step = session_->handleKey(key);
+
+	switch (step.action)
+	{
+	case GameAction::SET_VALUE:
+		telemetry_.recordMove(step.cell, step.value, step.conflicts);
+		if (step.won)
+		{
+			telemetry_.recordWin();
+		}
+		break;
+	case GameAction::TOGGLE_NOTE:
+		telemetry_.recordNote(step.cell, step.value);
+		break;
+	case GameAction::TOGGLE_NOTES_MODE:
+		printNotesMode();
+		break;
+	default:
+		break;
+	}
+
+	printChangedCells(step.previousCell);
+	return step;
+}
+
+
 void ConsoleWindow::setSize()
 {
 	char str[80];
@@ -200,6 +280,8 @@ void ConsoleWindow::printTitle()
 
 void ConsoleWindow::printGame()
 {
+	int actualCell = session_->getActualCell();
+
 	for (int i = 0, k = 0, m = 0; i < GameWindowSettings::GAME_BOARD_HEIGHT; i++)
 	{
 		SetConsoleCursorPosition(GetStdHandle(STD_OUTPUT_HANDLE), 
@@ -212,17 +294,17 @@ void ConsoleWindow::printGame()
 		{
 			int number = sudoku_->getValueAtIndex(n, m);
 			
-			if (i >= cTable[iActualCell_ / 9][iActualCell_ % 9].yPos && 
-				i <= cTable[iActualCell_ / 9][iActualCell_ % 9].yPos + GameWindowSettings::CELL_HEIGHT - 1 &&
-				j >= cTable[iActualCell_ / 9][iActualCell_ % 9].xPos &&
-				j <= cTable[iActualCell_ / 9][iActualCell_ % 9].xPos + GameWindowSettings::CELL_WIDTH - 1)
+			if (i >= cTable[actualCell / 9][actualCell % 9].yPos && 
+				i <= cTable[actualCell / 9][actualCell % 9].yPos + GameWindowSettings::CELL_HEIGHT - 1 &&
+				j >= cTable[actualCell / 9][actualCell % 9].xPos &&
+				j <= cTable[actualCell / 9][actualCell % 9].xPos + GameWindowSettings::CELL_WIDTH - 1)
 			{
 
-				if (i == cTable[iActualCell_ / 9][iActualCell_ % 9].yPos + GameWindowSettings::CELL_HEIGHT / 2 &&
-					j == cTable[iActualCell_ / 9][iActualCell_ % 9].xPos + GameWindowSettings::CELL_WIDTH  / 2)
+				if (i == cTable[actualCell / 9][actualCell % 9].yPos + GameWindowSettings::CELL_HEIGHT / 2 &&
+					j == cTable[actualCell / 9][actualCell % 9].xPos + GameWindowSettings::CELL_WIDTH  / 2)
 				{
 					SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 15);
-					std::cout << sudoku_->getValueAtIndex(iActualCell_ % 9, iActualCell_ / 9);
+					std::cout << sudoku_->getValueAtIndex(actualCell % 9, actualCell / 9);
 				}
 				else
 				{
@@ -330,6 +412,240 @@ void ConsoleWindow::printGame()
 	}
 }
 
+void ConsoleWindow::printCell(int row, int column)
+{
+	int value = watchedState_ != nullptr ? watchedState_->values[row * 9 + column] : sudoku_->getValueAtIndex(column, row);
+	std::uint16_t notes = watchedState_ != nullptr ? 0 : sudoku_->getNotes(column, row);
+	bool selected = session_->getActualCell() == row * 9 + column;
+	WORD attribute = 15;
+
+	if (selected)
+	{
+		attribute = BACKGROUND_BLUE;
+	}
+	else if (sudoku_->tryFindPositionSameNumber(row, column))
+	{
+		attribute = BACKGROUND_RED;
+	}
+	else if (!sudoku_->isNumberEditable(column, row))
+	{
+		attribute = BACKGROUND_INTENSITY;
+	}
+
+	for (int i = 0; i < GameWindowSettings::CELL_HEIGHT; i++)
+	{
+		SetConsoleCursorPosition(GetStdHandle(STD_OUTPUT_HANDLE),
+			COORD{
+				(short)(GameWindowSettings::GAME_BOARD_X_POS + cTable[row][column].xPos),
+				(short)(GameWindowSettings::GAME_BOARD_Y_POS + cTable[row][column].yPos + i)
+		});
+
+		for (int j = 0; j < GameWindowSettings::CELL_WIDTH; j++)
+		{
+			// Notes are laid out as 3x3 keypad in odd columns of the cell
+			if (value == 0 && notes != 0 && j % 2 == 1)
+			{
+				int note = i * 3 + j / 2 + 1;
+
+				SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), selected ? BACKGROUND_BLUE | 15 : attribute);
+				std::cout << (notes & (1 << note) ? char('0' + note) : ' ');
+			}
+			else if (!(value == 0 && notes != 0) &&
+				i == GameWindowSettings::CELL_HEIGHT / 2 && j == GameWindowSettings::CELL_WIDTH / 2)
+			{
+				SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), selected ? 15 : attribute);
+				std::cout << value;
+			}
+			else
+			{
+				SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), attribute);
+				std::cout << " ";
+			}
+		}
+	}
+}
+
+void ConsoleWindow::printChangedCells(int previousCell)
+{
+	for (int row = 0; row < 9; row++)
+	{
+		for (int column = 0; column < 9; column++)
+		{
+			bool sameNumber = sudoku_->tryFindPositionSameNumber(row, column);
+
+			if (sudoku_->isNumberChanged(column, row) || sameNumber || highlighted_[row][column] ||
+				row * 9 + column == session_->getActualCell() || row * 9 + column == previousCell)
+			{
+				printCell(row, column);
+			}
+
+			highlighted_[row][column] = sameNumber;
+		}
+	}
+
+	sudoku_->clearChanges();
+	while (sudoku_->getSameNumbers()->size() > 0)
+	{
+		sudoku_->removeFromSameNumbers();
+	}
+}
+
+void ConsoleWindow::printNotesMode()
+{
+	printStatus(session_->isNotesMode() ? "NOTES (n - numbers, f - fill notes, v - watch solving)" :
+		"NUMBERS (n - notes, f - fill notes, v - watch solving)");
+}
+
+size_t ConsoleWindow::watchSolving(const recordedKey* replayed, size_t count, bool realTime)
+{
+	int board[81];
+	searchState state;
+
+	// StepSolver knows only classic rules, it would show steps breaking the variant rules
+	if (!sudoku_->getRules().isClassic())
+	{
+		printStatus("Watching is available only for classic rules");
+		return 0;
+	}
+
+	for (int cell = 0; cell < 81; cell++)
+	{
+		board[cell] = sudoku_->getValueAtIndex(cell % 9, cell / 9);
+	}
+
+	// Numbers breaking the rules would make the search explore everything
+	if (!state.load(board))
+	{
+		printStatus("The numbers break the rules, there is nothing to watch");
+		return 0;
+	}
+
+	searchOptions options;
+	options.cellOrder = CellOrder::MIN_CANDIDATES;
+
+	StepSolver solver(state, options);
+	solveStep step;
+	bool changed[81] = { false };
+	int stepsPerFrame = 1;
+	bool paused = false;
+	bool isWatching = true;
+	size_t used = 0;
+	auto nextKey = std::chrono::steady_clock::now() + std::chrono::microseconds(count > 0 && realTime ? replayed[0].delay : 0);
+
+	watchedState_ = &solver.getState();
+
+	while (isWatching)
+	{
+		bool isReplayed = false;
+
+		// Keys after the stopping key belong to the game again
+		while (isWatching && (replayed == nullptr ? _kbhit() != 0 :
+			!isReplayed && used < count && std::chrono::steady_clock::now() >= nextKey))
+		{
+			char key;
+
+			if (replayed == nullptr)
+			{
+				key = _getch();
+				recorder_.record(key, session_->getStateHash());
+			}
+			else
+			{
+				key = replayed[used++].key;
+				nextKey = std::chrono::steady_clock::now() +
+					std::chrono::microseconds(used < count && realTime ? replayed[used].delay : 0);
+				isReplayed = true;
+			}
+
+			switch (key)
+			{
+			case ' ':
+				paused = !paused;
+				break;
+			case '+':
+				stepsPerFrame = stepsPerFrame < GameWindowSettings::WATCH_MAX_STEPS_PER_FRAME ? stepsPerFrame * 2 : stepsPerFrame;
+				break;
+			case '-':
+				stepsPerFrame = stepsPerFrame > 1 ? stepsPerFrame / 2 : 1;
+				break;
+			case 'v':
+			case 27:
+				isWatching = false;
+				break;
+			}
+		}
+
+		for (int i = 0; !paused && i < stepsPerFrame && solver.next(step); i++)
+		{
+			if (step.cell >= 0)
+			{
+				changed[step.cell] = true;
+			}
+		}
+
+		for (int cell = 0; cell < 81; cell++)
+		{
+			if (changed[cell])
+			{
+				printCell(cell / 9, cell % 9);
+				changed[cell] = false;
+			}
+		}
+
+		printWatchStatus(solver, stepsPerFrame, paused);
+
+		// Recording can end while watching, then there is no key to stop it
+		if (replayed != nullptr && used == count)
+		{
+			isWatching = false;
+		}
+		else if (replayed == nullptr || realTime)
+		{
+			Sleep(GameWindowSettings::WATCH_FRAME_MS);
+		}
+	}
+
+	watchedState_ = nullptr;
+
+	for (int cell = 0; cell < 81; cell++)
+	{
+		printCell(cell / 9, cell % 9);
+	}
+
+	printNotesMode();
+	return used;
+}
+
+void ConsoleWindow::printWatchStatus(const StepSolver& solver, int stepsPerFrame, bool paused)
+{
+	std::string text = "SOLVING ";
+
+	if (solver.isFinished())
+	{
+		text = solver.getState().emptyCount == 0 ? "SOLVED " : "NO SOLUTION ";
+	}
+	else if (paused)
+	{
+		text = "PAUSED ";
+	}
+
+	text += "nodes " + std::to_string(solver.getStats().nodes) +
+		" backtracks " + std::to_string(solver.getStats().backtracks) +
+		" x" + std::to_string(stepsPerFrame) + " (space, +, -, v)";
+	printStatus(text);
+}
+
+void ConsoleWindow::printStatus(const std::string& text)
+{
+	SetConsoleCursorPosition(GetStdHandle(STD_OUTPUT_HANDLE),
+		COORD{ (short)GameWindowSettings::GAME_BOARD_X_POS, (short)(GameWindowSettings::GAME_BOARD_Y_POS + GameWindowSettings::GAME_BOARD_HEIGHT + 1) });
+	SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), 15);
+	std::string line = text.substr(0, GameWindowSettings::STATUS_WIDTH);
+
+	line.resize(GameWindowSettings::STATUS_WIDTH, ' ');
+	std::cout << line;
+}
+
 void ConsoleWindow::showMessage(std::string message, MessageInfo info)
 {
 	bool isPrinted = true;
@@ -373,7 +689,7 @@ void ConsoleWindow::showMessage(std::string message, MessageInfo info)
 		c = _getch();
 		if (c == '\r')
 		{
-			exit((int)info);
+			isPrinted = false;
 		}
 	}
 }
@@ -4,6 +4,12 @@
 #include <string>
 #include <Windows.h>
 #include "Sudoku.h"
+#include "StepSolver.h"
+#include <chrono>
+#include <thread>
+#include "GameSession.h"
+#include "SessionRecorder.h"
+#include "Telemetry.h"
 
 // Mapping cell to position in console window
 struct Cell
@@ -23,6 +29,13 @@ namespace GameWindowSettings
 	const int CELL_HEIGHT = 3;
 	const int HORIZONTAL_SEPARATOR[] = { 7, 15, 23, 31, 39, 47, 55, 63 };
 	const int VERTICAL_SEPARATOR[] = { 3, 7, 11, 15, 19, 23, 27, 31 };
+	const char LIBRARY_FILE[] = "puzzles.lib";
+	const char PUZZLE_FILE[] = "text.txt";
+	const int STATUS_WIDTH = 71;
+	const int WATCH_FRAME_MS = 30;
+	const int WATCH_MAX_STEPS_PER_FRAME = 1 << 20;
+	const char TELEMETRY_FILE[] = "telemetry.bin";
+	const char RECORD_FILE[] = "session.rec";
 }
 
 // Represent key event constants
@@ -53,6 +66,15 @@ public:
 		Represents game loop
 	*/
 	void run();
+
+	/*
+		Plays recorded session on the board and shows how long
+		the playback took and how many states differed
+
+		@param recording Recorded session
+		@param realTime Decides if the recorded delays are kept
+	*/
+	void replay(const sessionRecording& recording, bool realTime);
 private:
 	/*
 		Sets size of console window
@@ -74,11 +96,70 @@ private:
 	*/
 	void printTitle();
 	
+	/*
+		Applies key to the game, records it in telemetry and
+		prints what changed
+
+		@param key Pressed key
+		@return What the key did
+	*/
+	gameStep applyKey(char key);
+
 	/*
 		Prints game after each update
 	*/
 	void printGame();
 
+	/*
+		Prints one cell with its number or candidate notes
+
+		@param row Row of the cell
+		@param column Column of the cell
+	*/
+	void printCell(int row, int column);
+
+	/*
+		Prints only cells that changed, are selected or
+		were highlighted as the same numbers
+
+		@param previousCell Cell selected before the update
+	*/
+	void printChangedCells(int previousCell);
+
+	/*
+		Prints whether digits are written as notes
+	*/
+	void printNotesMode();
+
+	/*
+		Animates search of the board from the numbers of player,
+		input is polled between frames so the animation can be
+		paused, sped up, slowed down or stopped at any step, keys
+		from keyboard are recorded, replayed keys come one per frame
+
+		@param replayed Recorded keys read instead of keyboard, null reads keyboard
+		@param count Count of recorded keys
+		@param realTime Decides if the recorded keys wait for their delays
+		@return count of read recorded keys
+	*/
+	size_t watchSolving(const recordedKey* replayed = nullptr, size_t count = 0, bool realTime = false);
+
+	/*
+		Prints progress of the watched search
+
+		@param solver Watched search
+		@param stepsPerFrame Count of steps made in one frame
+		@param paused If the animation is paused
+	*/
+	void printWatchStatus(const StepSolver& solver, int stepsPerFrame, bool paused);
+
+	/*
+		Prints text into status line under the board
+
+		@param text Printed text
+	*/
+	void printStatus(const std::string& text);
+
 	/*
 		Shows message to base info
 
@@ -93,13 +174,25 @@ private:
 	// Represents column in window
 	int iCols_;
 	
-	// Represent cell that cursor is pointing
-	int iActualCell_;
-	
 	// Represents container of cells
 	Cell cTable[9][9];
 
+	// Represents cells highlighted as the same numbers in the last update
+	bool highlighted_[9][9];
+
+	// Represents state shown instead of playing board while search is watched
+	const searchState* watchedState_;
+
 	// Represents sudoku game
 	Sudoku* sudoku_;
+
+	// Represents game logic driven by keys
+	GameSession* session_;
+
+	// Represents recording of keys of the session
+	SessionRecorder recorder_;
+
+	// Represents recording of moves of the session
+	Telemetry telemetry_;
 };
 
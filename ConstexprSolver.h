@@ -0,0 +1,159 @@
+#pragma once
+#include <cstdint>
+#include "Solver.h"
+
+
+/*
+	Represents backtracking search that can run while compiling,
+	it's used for built-in puzzles so their solutions are stored
+	in the binary instead of being searched on every launch
+*/
+namespace ConstexprSolver
+{
+	/*
+		Represents problem with its solution and count of solutions
+	*/
+	struct result
+	{
+		// Problem in row-major order, 0 means empty cell
+		int problem[81];
+		// The first found solution
+		int solution[81];
+		// Count of solutions, the counting stops at 2
+		int count;
+		// If the text has 81 cells and the givens don't break rules
+		bool valid;
+	};
+
+	constexpr int getSquare(int cell)
+	{
+		return cell / 27 * 3 + cell % 9 / 3;
+	}
+
+	/*
+		Parses line of 81 characters where '.' or '0' is empty cell
+		and counts solutions up to 2 by search choosing the cell with
+		the fewest candidates
+
+		@param text Line with the problem
+		@return Problem, its first solution and count of solutions
+	*/
+	constexpr result solve(const char (&text)[82])
+	{
+		result found = { {}, {}, 0, true };
+		int values[81] = {};
+		int cells[81] = {};
+		unsigned remaining[81] = {};
+		// Used values of rows 0..8, columns 9..17 and squares 18..26
+		unsigned used[27] = {};
+		int depth = 0;
+
+		for (int cell = 0; cell < 81; cell++)
+		{
+			char letter = text[cell];
+
+			if (letter >= '1' && letter <= '9')
+			{
+				unsigned bit = 1u << (letter - '0');
+				unsigned& row = used[cell / 9];
+				unsigned& column = used[9 + cell % 9];
+				unsigned& square = used[18 + getSquare(cell)];
+
+				if ((row | column | square) & bit)
+				{
+					found.valid = false;
+					return found;
+				}
+
+				values[cell] = letter - '0';
+				found.problem[cell] = values[cell];
+				row |= bit;
+				column |= bit;
+				square |= bit;
+			}
+			else if (letter != '.' && letter != '0')
+			{
+				found.valid = false;
+				return found;
+			}
+		}
+
+		while (true)
+		{
+			int best = -1;
+			int bestCount = 10;
+			unsigned bestMask = 0;
+
+			for (int cell = 0; cell < 81 && bestCount > 1; cell++)
+			{
+				if (values[cell] == 0)
+				{
+					unsigned mask = 0x3FEu & ~(used[cell / 9] | used[9 + cell % 9] | used[18 + getSquare(cell)]);
+					int count = countBits(static_cast<std::uint16_t>(mask));
+
+					if (count < bestCount)
+					{
+						best = cell;
+						bestCount = count;
+						bestMask = mask;
+					}
+				}
+			}
+
+			if (best < 0)
+			{
+				if (found.count == 0)
+				{
+					for (int cell = 0; cell < 81; cell++)
+					{
+						found.solution[cell] = values[cell];
+					}
+				}
+
+				if (++found.count == 2)
+				{
+					return found;
+				}
+			}
+			else
+			{
+				cells[depth] = best;
+				remaining[depth] = bestMask;
+				depth++;
+			}
+
+			// Withdraws exhausted decisions and places next candidate
+			while (depth > 0)
+			{
+				int cell = cells[depth - 1];
+
+				if (values[cell] != 0)
+				{
+					unsigned bit = 1u << values[cell];
+					used[cell / 9] &= ~bit;
+					used[9 + cell % 9] &= ~bit;
+					used[18 + getSquare(cell)] &= ~bit;
+					values[cell] = 0;
+				}
+
+				if (remaining[depth - 1] != 0)
+				{
+					unsigned bit = remaining[depth - 1] & (0u - remaining[depth - 1]);
+					remaining[depth - 1] &= ~bit;
+					values[cell] = countBits(static_cast<std::uint16_t>(bit - 1));
+					used[cell / 9] |= bit;
+					used[9 + cell % 9] |= bit;
+					used[18 + getSquare(cell)] |= bit;
+					break;
+				}
+
+				depth--;
+			}
+
+			if (depth == 0)
+			{
+				return found;
+			}
+		}
+	}
+}
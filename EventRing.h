@@ -0,0 +1,113 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+
+/*
+	Represents bounded lock-free ring for one producer and one
+	consumer, each side owns its position and only reads the
+	other one, so neither push nor pop ever waits
+*/
+template <typename T>
+class EventRing
+{
+public:
+	/*
+		Creates ring, the capacity is rounded up to power of two
+
+		@param capacity Minimal count of items
+	*/
+	EventRing(size_t capacity)
+	{
+		size_t size = 2;
+
+		while (size < capacity)
+		{
+			size *= 2;
+		}
+
+		items_.reset(new T[size]);
+		mask_ = size - 1;
+		head_.store(0, std::memory_order_relaxed);
+		tail_.store(0, std::memory_order_relaxed);
+	}
+
+	/*
+		Pushes item if there is free slot, it may be called
+		only from the producer thread
+
+		@param item Pushed item
+		@return if the item was pushed
+	*/
+	bool tryPush(const T& item)
+	{
+		size_t tail = tail_.load(std::memory_order_relaxed);
+
+		if (tail - head_.load(std::memory_order_acquire) > mask_)
+		{
+			return false;
+		}
+
+		items_[tail & mask_] = item;
+		tail_.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/*
+		Pops item if there is any, it may be called only from
+		the consumer thread
+
+		@param item Popped item
+		@return if the item was popped
+	*/
+	bool tryPop(T& item)
+	{
+		size_t head = head_.load(std::memory_order_relaxed);
+
+		if (head == tail_.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+
+		item = items_[head & mask_];
+		head_.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/*
+		Get approximate count of items, it's exact only when
+		nobody pushes or pops
+
+		@return count of items
+	*/
+	size_t getSize() const
+	{
+		size_t tail = tail_.load(std::memory_order_relaxed);
+		size_t head = head_.load(std::memory_order_relaxed);
+
+		return tail > head ? tail - head : 0;
+	}
+
+	/*
+		Get count of slots
+
+		@return capacity of the ring
+	*/
+	size_t getCapacity() const
+	{
+		return mask_ + 1;
+	}
+private:
+	EventRing(const EventRing&);
+	EventRing& operator=(const EventRing&);
+private:
+	// Represents ring of items
+	std::unique_ptr<T[]> items_;
+	// Represents mask of the position
+	size_t mask_;
+	// Represents position of the next pop, it's apart from tail to avoid false sharing
+	alignas(64) std::atomic<size_t> head_;
+	// Represents position of the next push
+	alignas(64) std::atomic<size_t> tail_;
+};
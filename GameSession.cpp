@@ -0,0 +1,113 @@
+#include "GameSession.h"
+
+
+GameSession::GameSession(Sudoku& sudoku)
+{
+	sudoku_ = &sudoku;
+	actualCell_ = 0;
+	notesMode_ = false;
+}
+
+
+gameStep GameSession::handleKey(char key)
+{
+	gameStep step = gameStep{ GameAction::NONE, actualCell_, actualCell_, 0, 0, false };
+	int x = actualCell_ % 9;
+	int y = actualCell_ / 9;
+
+	switch (key)
+	{
+	case 'w':
+		actualCell_ = actualCell_ - 9 < 0 ? actualCell_ : actualCell_ - 9;
+		step.action = GameAction::MOVE_CURSOR;
+		break;
+	case 's':
+		actualCell_ = actualCell_ + 9 >= 81 ? actualCell_ : actualCell_ + 9;
+		step.action = GameAction::MOVE_CURSOR;
+		break;
+	case 'd':
+		actualCell_ = actualCell_ + 1 >= 81 ? actualCell_ : actualCell_ + 1;
+		step.action = GameAction::MOVE_CURSOR;
+		break;
+	case 'a':
+		actualCell_ = actualCell_ - 1 < 0 ? actualCell_ : actualCell_ - 1;
+		step.action = GameAction::MOVE_CURSOR;
+		break;
+	case '1':
+	case '2':
+	case '3':
+	case '4':
+	case '5':
+	case '6':
+	case '7':
+	case '8':
+	case '9':
+		step.value = key - '0';
+
+		if (notesMode_)
+		{
+			// Notes belong only to empty cells, so givens and filled cells ignore the key
+			if (sudoku_->isNumberEditable(x, y) && sudoku_->getValueAtIndex(x, y) == 0)
+			{
+				sudoku_->toggleNote(step.value, x, y);
+				step.action = GameAction::TOGGLE_NOTE;
+			}
+		}
+		else if (sudoku_->isNumberEditable(x, y))
+		{
+			sudoku_->setValue(step.value, x, y);
+			sudoku_->isValueValid(step.value, x, y, false);
+			step.action = GameAction::SET_VALUE;
+			step.conflicts = static_cast<int>(sudoku_->getSameNumbers()->size());
+
+			if (!sudoku_->isGameWon() && !sudoku_->isAnyPositionEmpty() && sudoku_->checkPlayerSolution())
+			{
+				sudoku_->setGameWon(true);
+				step.won = true;
+			}
+		}
+		break;
+	case 'n':
+		notesMode_ = !notesMode_;
+		step.action = GameAction::TOGGLE_NOTES_MODE;
+		break;
+	case 'f':
+		sudoku_->fillNotes();
+		step.action = GameAction::FILL_NOTES;
+		break;
+	case 'v':
+		step.action = GameAction::WATCH;
+		break;
+	}
+
+	step.cell = actualCell_;
+	return step;
+}
+
+
+int GameSession::getActualCell() const
+{
+	return actualCell_;
+}
+
+
+bool GameSession::isNotesMode() const
+{
+	return notesMode_;
+}
+
+
+std::uint64_t GameSession::getStateHash() const
+{
+	std::uint64_t mixed = (static_cast<std::uint64_t>(actualCell_) << 1 | (notesMode_ ? 1 : 0)) + 0x9E3779B97F4A7C15ULL;
+
+	// Notes aren't part of the board hash, so they are folded in FNV-1a style
+	for (int cell = 0; cell < 81; cell++)
+	{
+		mixed = (mixed ^ sudoku_->getNotes(cell % 9, cell / 9)) * 0x100000001B3ULL;
+	}
+
+	mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBULL;
+	return sudoku_->getHash() ^ mixed ^ (mixed >> 31);
+}
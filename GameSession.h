@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+#include "Sudoku.h"
+
+
+/*
+	Represents what the key did in the game
+*/
+enum class GameAction
+{
+	NONE, MOVE_CURSOR, SET_VALUE, TOGGLE_NOTE, TOGGLE_NOTES_MODE, FILL_NOTES, WATCH
+};
+
+
+/*
+	Represents result of one key
+*/
+struct gameStep
+{
+	// What the key did
+	GameAction action;
+	// Cell under cursor before the key
+	int previousCell;
+	// Cell under cursor after the key
+	int cell;
+	// Entered value or note, 0 if there is none
+	int value;
+	// Count of the same numbers found by entered value
+	int conflicts;
+	// Represents if the key won the game
+	bool won;
+};
+
+
+/*
+	Represents game logic driven by keys without any output, the
+	console only draws what the steps changed and the same logic
+	replays recorded sessions without terminal
+*/
+class GameSession
+{
+public:
+	/*
+		Creates session of the game, the game isn't owned
+
+		@param sudoku Played game
+	*/
+	GameSession(Sudoku& sudoku);
+
+	/*
+		Applies key to the game, "wasd" move cursor, digits enter
+		values or notes, 'n' toggles notes mode, 'f' fills notes and
+		'v' asks for watching the solver which is up to the caller
+
+		@param key Pressed key
+		@return What the key did
+	*/
+	gameStep handleKey(char key);
+
+	/*
+		Get cell under cursor
+
+		@return Index of the cell
+	*/
+	int getActualCell() const;
+
+	/*
+		Checks if digits toggle notes
+
+		@return if notes mode is on
+	*/
+	bool isNotesMode() const;
+
+	/*
+		Get hash of the state that keys can change, it covers
+		numbers, pencil notes, cursor and notes mode
+
+		@return Hash of the state
+	*/
+	std::uint64_t getStateHash() const;
+private:
+	// Represents played game
+	Sudoku* sudoku_;
+	// Represents cell under cursor
+	int actualCell_;
+	// Represents if digits toggle candidate notes
+	bool notesMode_;
+};
@@ -0,0 +1,350 @@
+#include "GridEnumerator.h"
+#include <cstring>
+#include <thread>
+#include "PuzzleCanonical.h"
+
+const int GridEnumerator::DEFAULT_SPLIT_EMPTY = 40;
+const int GridEnumerator::SYMMETRY_FACTOR = 72;
+const int GridEnumerator::PACKED_GRID_SIZE = 41;
+const int GridEnumerator::OUTPUT_CHUNK = 1024;
+
+
+GridEnumerator::GridEnumerator(int threads, int splitEmpty)
+{
+	threadCount_ = threads > 0 ? threads : 1;
+	splitEmpty_ = splitEmpty;
+	pending_ = 0;
+	grids_ = 0;
+	stopping_ = false;
+	output_ = nullptr;
+
+	for (int i = 0; i < threadCount_; i++)
+	{
+		queues_.emplace_back(new taskQueue());
+	}
+}
+
+
+enumerationStats GridEnumerator::enumerate(const int* band, const enumerationLimits& limits, std::ostream* output)
+{
+	auto start = std::chrono::steady_clock::now();
+	enumerationStats stats;
+
+	if (!isValidBand(band))
+	{
+		return stats;
+	}
+
+	limits_ = limits;
+	output_ = output;
+	grids_ = 0;
+	stopping_ = false;
+	distinct_.reset(limits.distinctCapacity > 0 ? new ConcurrentHashSet(limits.distinctCapacity) : nullptr);
+
+	// The first column of rows 3..8 gets the values missing in the band, the row
+	// with the smallest one opens the second band and both bands are sorted
+	int rest[6];
+	int restCount = 0;
+
+	for (int value = 1; value <= 9; value++)
+	{
+		if (value != band[0] && value != band[9] && value != band[18])
+		{
+			rest[restCount++] = value;
+		}
+	}
+
+	int created = 0;
+	for (int first = 1; first < 6; first++)
+	{
+		for (int second = first + 1; second < 6; second++)
+		{
+			enumerationTask task;
+			int other = 6;
+
+			memset(task.values, 0, sizeof(task.values));
+			for (int cell = 0; cell < 27; cell++)
+			{
+				task.values[cell] = static_cast<std::uint8_t>(band[cell]);
+			}
+
+			task.values[27] = static_cast<std::uint8_t>(rest[0]);
+			task.values[36] = static_cast<std::uint8_t>(rest[first]);
+			task.values[45] = static_cast<std::uint8_t>(rest[second]);
+
+			for (int i = 1; i < 6; i++)
+			{
+				if (i != first && i != second)
+				{
+					task.values[other++ * 9] = static_cast<std::uint8_t>(rest[i]);
+				}
+			}
+
+			queues_[created++ % threadCount_]->tasks.push_back(task);
+		}
+	}
+
+	pending_ = created;
+
+	std::vector<enumerationStats> threadStats(threadCount_);
+	std::vector<std::thread> threads;
+
+	for (int i = 0; i < threadCount_; i++)
+	{
+		threads.emplace_back(&GridEnumerator::work, this, i, &threadStats[i]);
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	for (const enumerationStats& local : threadStats)
+	{
+		stats.tasks += local.tasks;
+		stats.splits += local.splits;
+		stats.steals += local.steals;
+		stats.nodes += local.nodes;
+	}
+
+	stats.grids = grids_;
+	stats.grids = limits.maxGrids > 0 && stats.grids > limits.maxGrids ? limits.maxGrids : stats.grids;
+	stats.distinct = distinct_ != nullptr ? static_cast<long long>(distinct_->getSize()) : -1;
+	stats.complete = !stopping_;
+	stats.elapsedMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now() - start).count();
+	output_ = nullptr;
+
+	return stats;
+}
+
+
+bool GridEnumerator::isValidBand(const int* band)
+{
+	int board[81] = { 0 };
+	searchState state;
+
+	for (int cell = 0; cell < 27; cell++)
+	{
+		if (band[cell] < 1 || band[cell] > 9)
+		{
+			return false;
+		}
+
+		board[cell] = band[cell];
+	}
+
+	return state.load(board);
+}
+
+
+void GridEnumerator::normalizeBand(const int* band, int* normalized)
+{
+	int labels[10] = { 0 };
+
+	for (int column = 0; column < 9; column++)
+	{
+		labels[band[column]] = column + 1;
+	}
+
+	for (int cell = 0; cell < 27; cell++)
+	{
+		normalized[cell] = labels[band[cell]];
+	}
+}
+
+
+void GridEnumerator::work(int index, enumerationStats* stats)
+{
+	std::vector<char> buffer;
+	enumerationTask task;
+	bool stolen;
+
+	while (pending_.load(std::memory_order_acquire) > 0)
+	{
+		if (!takeTask(index, task, stolen))
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		stats->steals += stolen ? 1 : 0;
+
+		// Remaining subtrees are only drained after the stop
+		if (!stopping_.load(std::memory_order_relaxed))
+		{
+			processTask(index, task, buffer, *stats);
+		}
+
+		pending_.fetch_sub(1, std::memory_order_acq_rel);
+	}
+
+	flush(buffer);
+}
+
+
+bool GridEnumerator::takeTask(int index, enumerationTask& task, bool& stolen)
+{
+	{
+		taskQueue& own = *queues_[index];
+		std::lock_guard<std::mutex> lock(own.mutex);
+
+		if (!own.tasks.empty())
+		{
+			task = own.tasks.back();
+			own.tasks.pop_back();
+			stolen = false;
+			return true;
+		}
+	}
+
+	for (int i = 1; i < threadCount_; i++)
+	{
+		taskQueue& victim = *queues_[(index + i) % threadCount_];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+
+		if (!victim.tasks.empty())
+		{
+			task = victim.tasks.front();
+			victim.tasks.pop_front();
+			stolen = true;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+void GridEnumerator::processTask(int index, const enumerationTask& task, std::vector<char>& buffer, enumerationStats& stats)
+{
+	int board[81];
+	searchState state;
+
+	for (int cell = 0; cell < 81; cell++)
+	{
+		board[cell] = task.values[cell];
+	}
+
+	state.load(board);
+
+	if (state.emptyCount > splitEmpty_)
+	{
+		int best = -1;
+		int bestCount = 10;
+
+		for (int cell = 0; cell < 81; cell++)
+		{
+			int count = countBits(state.getCandidates(cell));
+
+			if (state.values[cell] == 0 && count < bestCount)
+			{
+				best = cell;
+				bestCount = count;
+			}
+		}
+
+		std::uint16_t candidates = state.getCandidates(best);
+		taskQueue& own = *queues_[index];
+		std::lock_guard<std::mutex> lock(own.mutex);
+
+		// The smallest value is pushed last so the owner continues with it
+		for (int value = 9; value >= 1; value--)
+		{
+			if (candidates & (1 << value))
+			{
+				enumerationTask child = task;
+
+				child.values[best] = static_cast<std::uint8_t>(value);
+				own.tasks.push_back(child);
+				pending_.fetch_add(1, std::memory_order_acq_rel);
+			}
+		}
+
+		stats.splits++;
+		return;
+	}
+
+	class gridVisitor : public SolutionVisitor
+	{
+	public:
+		gridVisitor(GridEnumerator& enumerator, std::vector<char>& buffer)
+			: enumerator_(enumerator), buffer_(buffer)
+		{
+		}
+
+		bool onSolution(const searchState& state) override
+		{
+			long long grid = enumerator_.grids_.fetch_add(1, std::memory_order_relaxed);
+
+			if (enumerator_.limits_.maxGrids > 0 && grid >= enumerator_.limits_.maxGrids)
+			{
+				enumerator_.stopping_ = true;
+				return false;
+			}
+
+			if (enumerator_.distinct_ != nullptr)
+			{
+				int board[81];
+
+				state.store(board);
+				if (enumerator_.distinct_->insert(PuzzleCanonical::getCanonicalGridHash(board)) == InsertResult::FULL)
+				{
+					enumerator_.stopping_ = true;
+				}
+			}
+
+			if (enumerator_.output_ != nullptr)
+			{
+				size_t offset = buffer_.size();
+
+				buffer_.resize(offset + PACKED_GRID_SIZE, 0);
+				for (int cell = 0; cell < 81; cell++)
+				{
+					buffer_[offset + cell / 2] |= static_cast<char>(state.values[cell] << (cell % 2 == 0 ? 0 : 4));
+				}
+
+				if (buffer_.size() >= static_cast<size_t>(OUTPUT_CHUNK * PACKED_GRID_SIZE))
+				{
+					enumerator_.flush(buffer_);
+				}
+			}
+
+			return !enumerator_.stopping_.load(std::memory_order_relaxed);
+		}
+	private:
+		GridEnumerator& enumerator_;
+		std::vector<char>& buffer_;
+	};
+
+	searchOptions options;
+	solveBudget budget;
+	solveStats taskStats;
+	gridVisitor visitor(*this, buffer);
+
+	// Propagation isn't used, almost every branch ends in a complete grid,
+	// so its scans cost more than the nodes they save
+	options.cellOrder = CellOrder::MIN_CANDIDATES;
+	budget.deadline = limits_.deadline;
+	budget.cancel = &stopping_;
+
+	if (Solver(options).enumerate(state, visitor, budget, taskStats) == SolveResult::BUDGET_EXHAUSTED)
+	{
+		stopping_ = true;
+	}
+
+	stats.tasks++;
+	stats.nodes += taskStats.nodes;
+}
+
+
+void GridEnumerator::flush(std::vector<char>& buffer)
+{
+	if (output_ != nullptr && !buffer.empty())
+	{
+		std::lock_guard<std::mutex> lock(outputMutex_);
+		output_->write(buffer.data(), buffer.size());
+	}
+
+	buffer.clear();
+}
@@ -0,0 +1,176 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+#include "ConcurrentHashSet.h"
+#include "Solver.h"
+
+
+/*
+	Represents limits of one enumeration, every limit is
+	disabled by default
+*/
+struct enumerationLimits
+{
+	// Count of grids after which the enumeration stops, 0 means unlimited
+	long long maxGrids = 0;
+	// Time when the enumeration stops
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+	// Capacity of set of canonical hashes, 0 disables counting of essentially different grids
+	size_t distinctCapacity = 0;
+};
+
+
+/*
+	Represents results of one enumeration
+*/
+struct enumerationStats
+{
+	// Count of enumerated grids, every one stands for SYMMETRY_FACTOR grids
+	long long grids = 0;
+	// Count of essentially different grids among enumerated ones, -1 if not counted
+	long long distinct = -1;
+	// Count of subtrees searched to the end
+	long long tasks = 0;
+	// Count of subtrees split into children
+	long long splits = 0;
+	// Count of subtrees taken from queue of other thread
+	long long steals = 0;
+	// Count of search nodes
+	long long nodes = 0;
+	// If every grid was enumerated
+	bool complete = false;
+	// Duration in microseconds
+	long long elapsedMicroseconds = 0;
+};
+
+
+/*
+	Represents enumeration of every grid that completes the first
+	band, grids differing only by order of rows inside the second
+	and third band or by order of these bands are enumerated once,
+	so the first column of rows 3..8 is fixed to 10 sorted choices,
+	subtrees are split until they are small enough and threads
+	steal the biggest waiting subtrees of each other
+*/
+class GridEnumerator
+{
+public:
+	/*
+		Creates enumerator
+
+		@param threads Count of threads searching subtrees
+		@param splitEmpty Subtrees with more empty cells are split
+	*/
+	GridEnumerator(int threads, int splitEmpty = DEFAULT_SPLIT_EMPTY);
+
+	/*
+		Enumerates grids completing the band
+
+		@param band Values of the first three rows in row-major order
+		@param limits Limits of the enumeration
+		@param output Stream where grids are written packed into 41
+			bytes like cells of library records, nullptr writes nothing
+		@return Statistics of the enumeration
+	*/
+	enumerationStats enumerate(const int* band, const enumerationLimits& limits, std::ostream* output);
+
+	/*
+		Checks if the three rows are valid first band
+
+		@param band Values of the first three rows in row-major order
+		@return if the rows are full and don't break the rules
+	*/
+	static bool isValidBand(const int* band);
+
+	/*
+		Relabels band so its first row is 1..9, every grid of the
+		band maps to grid of the normalized band
+
+		@param band Values of the first three rows in row-major order
+		@param normalized Rows where the relabeled band is written
+	*/
+	static void normalizeBand(const int* band, int* normalized);
+public:
+	const static int DEFAULT_SPLIT_EMPTY;
+	const static int SYMMETRY_FACTOR;
+	const static int PACKED_GRID_SIZE;
+	const static int OUTPUT_CHUNK;
+private:
+	// Represents subtree of the search
+	struct enumerationTask
+	{
+		std::uint8_t values[81];
+	};
+
+	// Represents subtrees owned by one thread
+	struct taskQueue
+	{
+		std::mutex mutex;
+		std::deque<enumerationTask> tasks;
+	};
+
+	/*
+		Takes subtrees from own queue or steals them until there
+		is no subtree left anywhere
+
+		@param index Index of the thread
+		@param stats Statistics of the thread
+	*/
+	void work(int index, enumerationStats* stats);
+
+	/*
+		Takes the deepest subtree of own queue or the biggest
+		subtree of other queue
+
+		@param index Index of the thread
+		@param task Taken subtree
+		@param stolen If the subtree was stolen
+		@return if any subtree was taken
+	*/
+	bool takeTask(int index, enumerationTask& task, bool& stolen);
+
+	/*
+		Splits subtree by the cell with the fewest candidates or
+		searches it to the end
+
+		@param index Index of the thread
+		@param task Processed subtree
+		@param buffer Grids waiting for output
+		@param stats Statistics of the thread
+	*/
+	void processTask(int index, const enumerationTask& task, std::vector<char>& buffer, enumerationStats& stats);
+
+	/*
+		Writes grids waiting for output
+
+		@param buffer Packed grids
+	*/
+	void flush(std::vector<char>& buffer);
+private:
+	// Represents count of threads
+	int threadCount_;
+	// Represents count of empty cells above which subtrees are split
+	int splitEmpty_;
+	// Represents queues of threads
+	std::vector<std::unique_ptr<taskQueue>> queues_;
+	// Represents count of subtrees that are queued or processed
+	std::atomic<long long> pending_;
+	// Represents count of enumerated grids
+	std::atomic<long long> grids_;
+	// Represents request to stop every search
+	std::atomic<bool> stopping_;
+	// Represents limits of the running enumeration
+	enumerationLimits limits_;
+	// Represents canonical hashes of enumerated grids
+	std::unique_ptr<ConcurrentHashSet> distinct_;
+	// Represents output of the running enumeration
+	std::ostream* output_;
+	// Represents lock of the output
+	std::mutex outputMutex_;
+};
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+
+/*
+	Represents read-only file mapped into memory
+*/
+class MappedFile
+{
+public:
+	MappedFile();
+	~MappedFile();
+
+	/*
+		Maps the whole file, previously mapped file is closed
+
+		@param filename Name of the file
+		@return if the file was mapped
+	*/
+	bool open(const std::string& filename);
+
+	/*
+		Unmaps the file
+	*/
+	void close();
+
+	/*
+		Get start of the mapped memory
+
+		@return start of the memory or nullptr if nothing is mapped
+	*/
+	const unsigned char* getData() const;
+
+	/*
+		Get size of the mapped file
+
+		@return size in bytes
+	*/
+	size_t getSize() const;
+private:
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+private:
+	// Represents start of the mapped memory
+	const unsigned char* data_;
+	// Represents size of the mapped memory
+	size_t size_;
+	// Represents handle of the file
+	void* file_;
+	// Represents handle of the mapping
+	void* mapping_;
+};
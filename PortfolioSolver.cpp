@@ -0,0 +1,152 @@
+#include "PortfolioSolver.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+
+PortfolioSolver::PortfolioSolver()
+{
+	strategies_ = getDefaultStrategies();
+}
+
+
+PortfolioSolver::PortfolioSolver(const std::vector<portfolioStrategy>& strategies)
+{
+	strategies_ = strategies;
+}
+
+
+SolveResult PortfolioSolver::solve(searchState& state, const solveBudget& budget, portfolioStats& stats) const
+{
+	auto start = std::chrono::steady_clock::now();
+	size_t count = strategies_.size();
+	std::atomic<bool> finished(false);
+	std::mutex mutex;
+	std::condition_variable changed;
+	std::vector<std::thread> threads;
+	SolveResult result = SolveResult::BUDGET_EXHAUSTED;
+	searchState solution = state;
+	size_t done = 0;
+
+	solveBudget strategyBudget = budget;
+	strategyBudget.cancel = &finished;
+	stats.winner = -1;
+	stats.strategies.assign(count, solveStats());
+
+	// Restarting strategies revisit dead subtrees, so they share states without solution
+	std::unique_ptr<TranspositionTable> transpositions;
+	for (const auto& strategy : strategies_)
+	{
+		if (strategy.options.restartNodes > 0 && strategy.options.transpositions == nullptr && !transpositions)
+		{
+			transpositions.reset(new TranspositionTable(TranspositionTable::DEFAULT_CAPACITY));
+		}
+	}
+
+	for (size_t i = 0; i < count; i++)
+	{
+		threads.emplace_back([&, i] {
+			searchState local = state;
+			searchOptions options = strategies_[i].options;
+
+			if (options.restartNodes > 0 && options.transpositions == nullptr)
+			{
+				options.transpositions = transpositions.get();
+			}
+
+			SolveResult strategyResult = Solver(options).solve(local, strategyBudget, stats.strategies[i]);
+
+			std::lock_guard<std::mutex> lock(mutex);
+			if (strategyResult != SolveResult::BUDGET_EXHAUSTED && stats.winner < 0)
+			{
+				stats.winner = static_cast<int>(i);
+				result = strategyResult;
+				solution = local;
+				finished = true;
+			}
+
+			done++;
+			changed.notify_all();
+		});
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+
+		while (done < count && stats.winner < 0)
+		{
+			if (budget.cancel == nullptr)
+			{
+				changed.wait(lock);
+			}
+			else if (budget.cancel->load(std::memory_order_relaxed))
+			{
+				finished = true;
+				break;
+			}
+			else
+			{
+				changed.wait_for(lock, std::chrono::milliseconds(1));
+			}
+		}
+	}
+
+	finished = true;
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	if (result == SolveResult::SOLVED)
+	{
+		state = solution;
+	}
+
+	stats.elapsedMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now() - start).count();
+
+	return result;
+}
+
+
+const std::vector<portfolioStrategy>& PortfolioSolver::getStrategies() const
+{
+	return strategies_;
+}
+
+
+std::vector<portfolioStrategy> PortfolioSolver::getDefaultStrategies()
+{
+	std::vector<portfolioStrategy> strategies(6);
+
+	strategies[0].name = "row-major/ascending";
+
+	strategies[1].name = "row-major/descending";
+	strategies[1].options.valueOrder = ValueOrder::DESCENDING;
+
+	strategies[2].name = "min-candidates/ascending";
+	strategies[2].options.cellOrder = CellOrder::MIN_CANDIDATES;
+
+	strategies[3].name = "min-candidates/descending";
+	strategies[3].options.cellOrder = CellOrder::MIN_CANDIDATES;
+	strategies[3].options.valueOrder = ValueOrder::DESCENDING;
+
+	strategies[4].name = "random/restarts-a";
+	strategies[4].options.cellOrder = CellOrder::RANDOM_MIN_CANDIDATES;
+	strategies[4].options.valueOrder = ValueOrder::RANDOM;
+	strategies[4].options.seed = 0x9E3779B97F4A7C15ULL;
+	strategies[4].options.restartNodes = 1000;
+
+	strategies[5].name = "random/restarts-b";
+	strategies[5].options.cellOrder = CellOrder::RANDOM_MIN_CANDIDATES;
+	strategies[5].options.valueOrder = ValueOrder::RANDOM;
+	strategies[5].options.seed = 0xD1B54A32D192ED03ULL;
+	strategies[5].options.restartNodes = 1000;
+
+	for (auto& strategy : strategies)
+	{
+		strategy.options.propagation = true;
+	}
+
+	return strategies;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "Solver.h"
+
+
+/*
+	Represents one search configuration in the portfolio
+*/
+struct portfolioStrategy
+{
+	// Name used in reports
+	std::string name;
+	// Configuration of the search
+	searchOptions options;
+};
+
+
+/*
+	Represents statistics of the portfolio solving
+*/
+struct portfolioStats
+{
+	// Index of the strategy that answered first, -1 if none
+	int winner = -1;
+	// Statistics of every strategy until it finished or was cancelled
+	std::vector<solveStats> strategies;
+	// Duration of the whole solving in microseconds
+	long long elapsedMicroseconds = 0;
+};
+
+
+/*
+	Represents solver that races several search configurations
+	on separate threads, the first definitive answer wins and
+	the other searches are cancelled
+*/
+class PortfolioSolver
+{
+public:
+	PortfolioSolver();
+
+	/*
+		Creates portfolio with specific strategies
+
+		@param strategies Strategies that are raced
+	*/
+	PortfolioSolver(const std::vector<portfolioStrategy>& strategies);
+
+	/*
+		Races strategies on the state, the budget applies to
+		every strategy and its cancel token stops all of them,
+		restarting strategies without own transposition table
+		share one
+
+		@param state State with loaded problem, it receives the solution
+		@param budget Limits of the solving
+		@param stats Statistics of the portfolio
+		@return Result of the winning strategy
+	*/
+	SolveResult solve(searchState& state, const solveBudget& budget, portfolioStats& stats) const;
+
+	/*
+		Get raced strategies
+
+		@return strategies
+	*/
+	const std::vector<portfolioStrategy>& getStrategies() const;
+
+	/*
+		Get default portfolio mixing cell orders, value orders
+		and randomized restarts, every strategy propagates
+		forced values
+
+		@return default strategies
+	*/
+	static std::vector<portfolioStrategy> getDefaultStrategies();
+private:
+	// Represents raced strategies
+	std::vector<portfolioStrategy> strategies_;
+};
@@ -0,0 +1,481 @@
+#include "PuzzleCanonical.h"
+
+namespace
+{
+	const int PERMUTATIONS[6][3] = {
+		{ 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 }
+	};
+
+	// Represents state of the search for the smallest equivalent board
+	struct canonicalSearch
+	{
+		int source[81];
+		int columnMap[9];
+		int current[81];
+		int best[81];
+		bool hasBest;
+		bool usedRow[9];
+	};
+
+	// Compares rows 0..rows-1 of current and best board
+	int comparePrefix(const canonicalSearch& search, int rows)
+	{
+		for (int i = 0; i < rows * 9; i++)
+		{
+			if (search.current[i] != search.best[i])
+			{
+				return search.current[i] < search.best[i] ? -1 : 1;
+			}
+		}
+
+		return 0;
+	}
+
+	void searchRows(canonicalSearch& search, int level, int band, const int* labels, int nextLabel)
+	{
+		if (level == 9)
+		{
+			if (!search.hasBest || comparePrefix(search, 9) < 0)
+			{
+				for (int i = 0; i < 81; i++)
+				{
+					search.best[i] = search.current[i];
+				}
+
+				search.hasBest = true;
+			}
+
+			return;
+		}
+
+		for (int candidate = 0; candidate < 9; candidate++)
+		{
+			int firstOfBand = candidate - candidate % 3;
+			bool bandUsed = search.usedRow[firstOfBand] || search.usedRow[firstOfBand + 1] ||
+				search.usedRow[firstOfBand + 2];
+
+			// The first row of every band chooses the band
+			if (search.usedRow[candidate] ||
+				(level % 3 == 0 && bandUsed) ||
+				(level % 3 != 0 && candidate / 3 != band))
+			{
+				continue;
+			}
+
+			int rowLabels[10];
+			int rowNextLabel = nextLabel;
+
+			for (int value = 0; value < 10; value++)
+			{
+				rowLabels[value] = labels[value];
+			}
+
+			for (int column = 0; column < 9; column++)
+			{
+				int value = search.source[candidate * 9 + search.columnMap[column]];
+
+				if (value != 0 && rowLabels[value] == 0)
+				{
+					rowLabels[value] = ++rowNextLabel;
+				}
+
+				search.current[level * 9 + column] = rowLabels[value];
+			}
+
+			if (search.hasBest && comparePrefix(search, level + 1) > 0)
+			{
+				continue;
+			}
+
+			search.usedRow[candidate] = true;
+			searchRows(search, level + 1, candidate / 3, rowLabels, rowNextLabel);
+			search.usedRow[candidate] = false;
+		}
+	}
+
+	// Represents partial order of columns that keeps stacks together
+	struct columnMapping
+	{
+		// Source column of every column, -1 if not chosen
+		int source[9];
+		// Column of every source column, -1 if not chosen
+		int target[9];
+		// Source stack of every stack, -1 if not chosen
+		int stackSource[3];
+		// Stack of every source stack, -1 if not chosen
+		int stackTarget[3];
+	};
+
+	// Represents state of the search for the smallest equivalent grid
+	struct gridSearch
+	{
+		// Rows of the source grid, transposed in the second orientation
+		int rows[9][9];
+		// Order of rows of the first band
+		int first;
+		int second;
+		int third;
+		// Column of every value in the first row
+		int firstColumn[10];
+		// Column in the first row of value in every column of the second row
+		int secondColumn[9];
+		int current[81];
+		int best[81];
+		bool hasBest;
+	};
+
+	bool canMap(const columnMapping& mapping, int column, int source)
+	{
+		return mapping.source[column] < 0 && mapping.target[source] < 0 &&
+			(mapping.stackSource[column / 3] == source / 3 ||
+			(mapping.stackSource[column / 3] < 0 && mapping.stackTarget[source / 3] < 0));
+	}
+
+	void map(columnMapping& mapping, int column, int source)
+	{
+		mapping.source[column] = source;
+		mapping.target[source] = column;
+		mapping.stackSource[column / 3] = source / 3;
+		mapping.stackTarget[source / 3] = column / 3;
+	}
+
+	// Gets relabeled value of the second row in column with the source column, the value
+	// is column of the same value in the first row, which is mapped as low as possible
+	int mapSecondRow(const gridSearch& search, columnMapping& mapping, int source)
+	{
+		int firstSource = search.secondColumn[source];
+
+		if (mapping.target[firstSource] < 0)
+		{
+			for (int column = 0; column < 9; column++)
+			{
+				if (canMap(mapping, column, firstSource))
+				{
+					map(mapping, column, firstSource);
+					break;
+				}
+			}
+		}
+
+		return mapping.target[firstSource] + 1;
+	}
+
+	// Writes rows of the complete mapping while they aren't greater than the best grid, the
+	// smallest row opens the second band and the rest of every band is sorted
+	void completeGrid(gridSearch& search, const columnMapping& mapping)
+	{
+		int labels[10];
+		int rows[9];
+		int firstValues[9];
+		bool smaller = !search.hasBest;
+
+		for (int value = 1; value <= 9; value++)
+		{
+			labels[value] = mapping.target[search.firstColumn[value]] + 1;
+		}
+
+		// Rows never match in the first column, so it decides the order of rows of a band
+		for (int row = 0; row < 9; row++)
+		{
+			firstValues[row] = labels[search.rows[row][mapping.source[0]]];
+		}
+
+		int firstBand = search.first / 3;
+		int secondBand = (firstBand + 1) % 3;
+		int thirdBand = (firstBand + 2) % 3;
+		int smallest = secondBand * 3;
+
+		rows[0] = search.first;
+		rows[1] = search.second;
+		rows[2] = search.third;
+
+		for (int row = 0; row < 9; row++)
+		{
+			if (row / 3 != firstBand && firstValues[row] < firstValues[smallest])
+			{
+				smallest = row;
+			}
+		}
+
+		if (smallest / 3 != secondBand)
+		{
+			thirdBand = secondBand;
+			secondBand = smallest / 3;
+		}
+
+		for (int i = 0; i < 3; i++)
+		{
+			rows[3 + i] = secondBand * 3 + i;
+			rows[6 + i] = thirdBand * 3 + i;
+		}
+
+		for (int band = 1; band < 3; band++)
+		{
+			int* sorted = rows + band * 3;
+
+			// Sorting network of three rows
+			for (int i = 0; i < 3; i++)
+			{
+				int low = i == 2 ? 1 : 0;
+				int high = i == 0 ? 1 : 2;
+
+				if (firstValues[sorted[high]] < firstValues[sorted[low]])
+				{
+					int swapped = sorted[low];
+					sorted[low] = sorted[high];
+					sorted[high] = swapped;
+				}
+			}
+		}
+
+		// The first row is 1..9 in every grid
+		for (int cell = 9; cell < 81; cell++)
+		{
+			search.current[cell] = labels[search.rows[rows[cell / 9]][mapping.source[cell % 9]]];
+
+			if (!smaller && search.current[cell] != search.best[cell])
+			{
+				if (search.current[cell] > search.best[cell])
+				{
+					return;
+				}
+
+				smaller = true;
+			}
+		}
+
+		for (int cell = 0; cell < 81; cell++)
+		{
+			search.best[cell] = search.current[cell];
+		}
+
+		search.hasBest = true;
+	}
+
+	// Gets the value mapSecondRow gives after the column takes the source column
+	int getSecondRowValue(const gridSearch& search, const columnMapping& mapping, int column, int source)
+	{
+		int firstSource = search.secondColumn[source];
+
+		if (mapping.target[firstSource] >= 0)
+		{
+			return mapping.target[firstSource] + 1;
+		}
+
+		// Both columns are in different stacks, values of a row never repeat in a square
+		int stack = mapping.stackTarget[firstSource / 3];
+
+		for (int free = 0; stack < 0; free++)
+		{
+			stack = mapping.stackSource[free] < 0 && free != column / 3 ? free : -1;
+		}
+
+		for (int target = stack * 3; ; target++)
+		{
+			if (mapping.source[target] < 0 && target != column)
+			{
+				return target + 1;
+			}
+		}
+	}
+
+	// Maps columns in order, every column takes the source column that gives
+	// the smallest value of the second row
+	void searchColumns(gridSearch& search, const columnMapping& mapping, int column)
+	{
+		if (column == 9)
+		{
+			completeGrid(search, mapping);
+			return;
+		}
+
+		int sources[9];
+		int values[9];
+		int count = 0;
+		int smallest = 10;
+
+		for (int source = 0; source < 9; source++)
+		{
+			if (mapping.source[column] >= 0 ? mapping.source[column] != source : !canMap(mapping, column, source))
+			{
+				continue;
+			}
+
+			sources[count] = source;
+			values[count] = getSecondRowValue(search, mapping, column, source);
+			smallest = values[count] < smallest ? values[count] : smallest;
+			count++;
+		}
+
+		search.current[9 + column] = smallest;
+
+		for (int i = 9; i <= 9 + column && search.hasBest; i++)
+		{
+			if (search.current[i] != search.best[i])
+			{
+				if (search.current[i] > search.best[i])
+				{
+					return;
+				}
+
+				break;
+			}
+		}
+
+		for (int i = 0; i < count; i++)
+		{
+			if (values[i] == smallest)
+			{
+				columnMapping child = mapping;
+
+				map(child, column, sources[i]);
+				mapSecondRow(search, child, sources[i]);
+				searchColumns(search, child, column + 1);
+			}
+		}
+	}
+}
+
+
+void PuzzleCanonical::canonicalize(const int* board, int* canonical)
+{
+	canonicalSearch search;
+	int noLabels[10] = { 0 };
+
+	search.hasBest = false;
+	for (int row = 0; row < 9; row++)
+	{
+		search.usedRow[row] = false;
+	}
+
+	for (int orientation = 0; orientation < 2; orientation++)
+	{
+		for (int cell = 0; cell < 81; cell++)
+		{
+			search.source[cell] = orientation == 0 ? board[cell] : board[(cell % 9) * 9 + cell / 9];
+		}
+
+		for (int stacks = 0; stacks < 6; stacks++)
+		{
+			for (int first = 0; first < 6; first++)
+			{
+				for (int second = 0; second < 6; second++)
+				{
+					for (int third = 0; third < 6; third++)
+					{
+						const int* inside[3] = { PERMUTATIONS[first], PERMUTATIONS[second], PERMUTATIONS[third] };
+
+						for (int column = 0; column < 9; column++)
+						{
+							search.columnMap[column] = PERMUTATIONS[stacks][column / 3] * 3 + inside[column / 3][column % 3];
+						}
+
+						searchRows(search, 0, 0, noLabels, 0);
+					}
+				}
+			}
+		}
+	}
+
+	for (int cell = 0; cell < 81; cell++)
+	{
+		canonical[cell] = search.best[cell];
+	}
+}
+
+
+void PuzzleCanonical::canonicalizeGrid(const int* grid, int* canonical)
+{
+	gridSearch search;
+	columnMapping empty;
+
+	search.hasBest = false;
+	for (int i = 0; i < 9; i++)
+	{
+		empty.source[i] = -1;
+		empty.target[i] = -1;
+		empty.stackSource[i / 3] = -1;
+		empty.stackTarget[i / 3] = -1;
+	}
+
+	for (int orientation = 0; orientation < 2; orientation++)
+	{
+		for (int cell = 0; cell < 81; cell++)
+		{
+			search.rows[cell / 9][cell % 9] = orientation == 0 ? grid[cell] : grid[(cell % 9) * 9 + cell / 9];
+		}
+
+		// Any row can be the first one, every order of columns relabels it to 1..9
+		for (int first = 0; first < 9; first++)
+		{
+			for (int other = 1; other <= 2; other++)
+			{
+				search.first = first;
+				search.second = first - first % 3 + (first % 3 + other) % 3;
+				search.third = first - first % 3 + (first % 3 + 3 - other) % 3;
+
+				for (int column = 0; column < 9; column++)
+				{
+					search.firstColumn[search.rows[first][column]] = column;
+				}
+
+				for (int column = 0; column < 9; column++)
+				{
+					search.secondColumn[column] = search.firstColumn[search.rows[search.second][column]];
+				}
+
+				for (int column = 0; column < 9; column++)
+				{
+					search.current[column] = column + 1;
+				}
+
+				// The second row starts with 456 only if its first square is a whole square
+				// of the first row, otherwise it starts with 457 at best
+				bool whole = search.secondColumn[0] / 3 == search.secondColumn[1] / 3 &&
+					search.secondColumn[0] / 3 == search.secondColumn[2] / 3;
+
+				if (!search.hasBest || whole || search.best[11] != 6)
+				{
+					searchColumns(search, empty, 0);
+				}
+			}
+		}
+	}
+
+	for (int cell = 0; cell < 81; cell++)
+	{
+		canonical[cell] = search.best[cell];
+	}
+}
+
+
+std::uint64_t PuzzleCanonical::getCanonicalHash(const int* board)
+{
+	int canonical[81];
+
+	canonicalize(board, canonical);
+	return getHash(canonical);
+}
+
+
+std::uint64_t PuzzleCanonical::getCanonicalGridHash(const int* grid)
+{
+	int canonical[81];
+
+	canonicalizeGrid(grid, canonical);
+	return getHash(canonical);
+}
+
+
+std::uint64_t PuzzleCanonical::getHash(const int* board)
+{
+	std::uint64_t hash = 14695981039346656037ULL;
+
+	for (int cell = 0; cell < 81; cell++)
+	{
+		hash ^= static_cast<std::uint64_t>(board[cell]);
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+
+
+/*
+	Represents canonical form of puzzles, all puzzles that differ only
+	by transposition, swapping of bands, stacks, rows inside a band,
+	columns inside a stack and relabeling of values have the same form
+*/
+class PuzzleCanonical
+{
+public:
+	/*
+		Finds lexicographically smallest equivalent board, values are
+		relabeled in the order of their first appearance
+
+		@param board Problem in row-major order
+		@param canonical Board where the canonical form is written
+	*/
+	static void canonicalize(const int* board, int* canonical);
+
+	/*
+		Finds the same form as canonicalize for completed grid, the
+		first row always becomes 1..9, so only orders of columns that
+		keep the second row the smallest are searched and the lower
+		bands are sorted without search
+
+		@param grid Completed grid in row-major order
+		@param canonical Grid where the canonical form is written
+	*/
+	static void canonicalizeGrid(const int* grid, int* canonical);
+
+	/*
+		Get 64-bit hash of the canonical form
+
+		@param board Problem in row-major order
+		@return Hash of the canonical form
+	*/
+	static std::uint64_t getCanonicalHash(const int* board);
+
+	/*
+		Get 64-bit hash of the canonical form of completed grid
+
+		@param grid Completed grid in row-major order
+		@return Hash of the canonical form
+	*/
+	static std::uint64_t getCanonicalGridHash(const int* grid);
+
+	/*
+		Get 64-bit FNV-1a hash of the board as it is
+
+		@param board Board in row-major order
+		@return Hash of the board
+	*/
+	static std::uint64_t getHash(const int* board);
+};
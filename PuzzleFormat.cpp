@@ -0,0 +1,256 @@
+#include "PuzzleFormat.h"
+#include <sstream>
+
+
+bool PuzzleFormat::parse(const std::string& text, int* board)
+{
+	if (text.find('[') == std::string::npos)
+	{
+		return parseLine(text, board);
+	}
+
+	return parseEntries(text, board);
+}
+
+
+bool PuzzleFormat::parse(const std::string& text, int* board, PuzzleRules& rules)
+{
+	std::stringstream ss(text);
+	std::string line;
+	std::string problem;
+	bool valid = true;
+
+	rules.reset();
+	while (std::getline(ss, line))
+	{
+		if (!parseRule(line, rules, valid))
+		{
+			problem += line + "\n";
+		}
+	}
+
+	return parse(problem, board) && valid;
+}
+
+
+bool PuzzleFormat::parseRule(const std::string& line, PuzzleRules& rules, bool& valid)
+{
+	std::stringstream ss(line);
+	std::string word;
+
+	ss >> word;
+	if (word == "diagonal")
+	{
+		rules.addDiagonals();
+	}
+	else if (word == "regions")
+	{
+		int regions[81];
+		int cell = 0;
+		char letter;
+
+		while (ss >> letter)
+		{
+			if (cell >= 81 || letter < '1' || letter > '9')
+			{
+				valid = false;
+				return true;
+			}
+
+			regions[cell++] = letter - '1';
+		}
+
+		if (cell != 81 || !rules.setRegions(regions))
+		{
+			valid = false;
+		}
+	}
+	else if (word == "cage")
+	{
+		int cells[9];
+		int size = 0;
+		int sum = 0;
+		std::string entry;
+
+		ss >> sum;
+		while (ss >> entry)
+		{
+			int row = -1;
+			int column = -1;
+			int value = -1;
+
+			getDataFromString(entry, row, column, value);
+			if (size >= 9 || row < 0 || row >= 9 || column < 0 || column >= 9)
+			{
+				valid = false;
+				return true;
+			}
+
+			cells[size++] = row * 9 + column;
+		}
+
+		if (!rules.addCage(cells, size, sum))
+		{
+			valid = false;
+		}
+	}
+	else
+	{
+		return false;
+	}
+
+	return true;
+}
+
+
+bool PuzzleFormat::parseLine(const std::string& line, int* board)
+{
+	int cell = 0;
+
+	for (char letter : line)
+	{
+		if (letter == ' ' || letter == '\t' || letter == '\r' || letter == '\n')
+		{
+			continue;
+		}
+
+		if (cell >= 81)
+		{
+			return false;
+		}
+
+		if (letter == '.')
+		{
+			board[cell++] = 0;
+		}
+		else if (letter >= '0' && letter <= '9')
+		{
+			board[cell++] = letter - '0';
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	return cell == 81;
+}
+
+
+bool PuzzleFormat::parseEntries(const std::string& text, int* board)
+{
+	std::stringstream ss(text);
+	std::string entry;
+	bool anyEntry = false;
+
+	for (int cell = 0; cell < 81; cell++)
+	{
+		board[cell] = 0;
+	}
+
+	while (ss >> entry)
+	{
+		int row = -1;
+		int column = -1;
+		int value = -1;
+
+		getDataFromString(entry, row, column, value);
+		if (row < 0 || row >= 9 || column < 0 || column >= 9 ||
+			value < 0 || value > 9)
+		{
+			continue;
+		}
+
+		board[row * 9 + column] = value;
+		anyEntry = true;
+	}
+
+	return anyEntry;
+}
+
+
+std::string PuzzleFormat::toLine(const int* board)
+{
+	std::string line(81, '.');
+
+	for (int cell = 0; cell < 81; cell++)
+	{
+		if (board[cell] > 0)
+		{
+			line[cell] = static_cast<char>('0' + board[cell]);
+		}
+	}
+
+	return line;
+}
+
+
+std::string PuzzleFormat::toText(const int* board, const PuzzleRules& rules)
+{
+	std::stringstream ss;
+
+	ss << toLine(board) << "\n";
+	if (rules.hasDiagonals())
+	{
+		ss << "diagonal\n";
+	}
+
+	if (rules.getUnit(18).kind == UnitKind::REGION)
+	{
+		ss << "regions ";
+		for (int cell = 0; cell < 81; cell++)
+		{
+			ss << rules.getRegionOfCell(cell) + 1;
+		}
+
+		ss << "\n";
+	}
+
+	for (int unit = 0; unit < rules.getUnitCount(); unit++)
+	{
+		const ruleUnit& cage = rules.getUnit(unit);
+
+		if (cage.kind != UnitKind::CAGE)
+		{
+			continue;
+		}
+
+		ss << "cage " << cage.sum;
+		for (int i = 0; i < cage.size; i++)
+		{
+			ss << " [" << cage.cells[i] / 9 << "," << cage.cells[i] % 9 << "]";
+		}
+
+		ss << "\n";
+	}
+
+	return ss.str();
+}
+
+
+void PuzzleFormat::getDataFromString(const std::string& str, int& row, int& column, int& value)
+{
+	std::stringstream ss(str);
+	char letter;
+	int i = 0;
+
+	while (ss >> letter)
+	{
+		if (letter >= '0' && letter <= '9')
+		{
+			switch (i)
+			{
+			case 0:
+				row = letter - '0';
+				i++;
+				break;
+			case 1:
+				column = letter - '0';
+				i++;
+				break;
+			case 2:
+				value = letter - '0';
+			}
+		}
+	}
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <string>
+#include "PuzzleRules.h"
+
+
+/*
+	Represents reading and writing of sudoku problems, supported
+	are entries "[row,column]:value" separated by whitespaces and
+	single line of 81 characters where '0' or '.' is empty cell,
+	variant rules are written on their own lines next to problem:
+		diagonal
+		regions <81 digits 1..9 with region of every cell>
+		cage <sum> [row,column] [row,column] ...
+*/
+class PuzzleFormat
+{
+public:
+	/*
+		Parses problem in any supported format
+
+		@param text Text with problem
+		@param board Board of 81 numbers in row-major order
+		@return if the text contains problem
+	*/
+	static bool parse(const std::string& text, int* board);
+
+	/*
+		Parses problem in any supported format together with
+		lines of variant rules
+
+		@param text Text with problem and rules
+		@param board Board of 81 numbers in row-major order
+		@param rules Rules that are reset and filled from the text
+		@return if the text contains problem and every rule is valid
+	*/
+	static bool parse(const std::string& text, int* board, PuzzleRules& rules);
+
+	/*
+		Parses one line of variant rule
+
+		@param line Line with rule
+		@param rules Rules where the rule is added
+		@param valid Set to false if the rule is malformed
+		@return if the line is rule
+	*/
+	static bool parseRule(const std::string& line, PuzzleRules& rules, bool& valid);
+
+	/*
+		Parses problem written as line of 81 characters
+
+		@param line Line with problem
+		@param board Board of 81 numbers in row-major order
+		@return if the line has valid format
+	*/
+	static bool parseLine(const std::string& line, int* board);
+
+	/*
+		Parses problem written as entries "[row,column]:value",
+		malformed entries are skipped
+
+		@param text Text with entries
+		@param board Board of 81 numbers in row-major order
+		@return if at least one entry was read
+	*/
+	static bool parseEntries(const std::string& text, int* board);
+
+	/*
+		Writes board as line of 81 characters
+
+		@param board Board of 81 numbers in row-major order
+		@return Line with board
+	*/
+	static std::string toLine(const int* board);
+
+	/*
+		Writes board as line of 81 characters followed by lines
+		of variant rules
+
+		@param board Board of 81 numbers in row-major order
+		@param rules Rules of the puzzle
+		@return Text with board and rules
+	*/
+	static std::string toText(const int* board, const PuzzleRules& rules);
+
+	/*
+		Extracts indexes with specific values from string
+		to ref variables
+
+		@param str String with data
+		@param row Index of row from string
+		@param column Index of column from string
+		@param value Value from string
+	*/
+	static void getDataFromString(const std::string& str, int& row, int& column, int& value);
+};
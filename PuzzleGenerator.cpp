@@ -0,0 +1,104 @@
+#include "PuzzleGenerator.h"
+
+const long long PuzzleGenerator::UNIQUENESS_NODE_BUDGET = 1000000;
+
+
+PuzzleGenerator::PuzzleGenerator(std::uint64_t seed)
+{
+	random_ = seed != 0 ? seed : 1;
+}
+
+
+void PuzzleGenerator::generateGrid(int* grid)
+{
+	searchOptions options;
+	searchState state;
+	solveBudget budget;
+	solveStats stats;
+	int empty[81] = { 0 };
+
+	options.valueOrder = ValueOrder::RANDOM;
+	options.seed = nextRandom();
+	options.propagation = true;
+
+	state.load(empty);
+	Solver(options).solve(state, budget, stats);
+	state.store(grid);
+}
+
+
+int PuzzleGenerator::removeClues(const int* grid, int* puzzle, int minClues)
+{
+	searchOptions options;
+	solveBudget budget;
+	searchState state;
+	int order[81];
+	int clues = 81;
+
+	options.cellOrder = CellOrder::MIN_CANDIDATES;
+	options.propagation = true;
+	budget.maxNodes = UNIQUENESS_NODE_BUDGET;
+	state.load(grid);
+
+	for (int cell = 0; cell < 81; cell++)
+	{
+		order[cell] = cell;
+	}
+
+	for (int i = 80; i > 0; i--)
+	{
+		int j = static_cast<int>(nextRandom() % (i + 1));
+		int swapped = order[i];
+		order[i] = order[j];
+		order[j] = swapped;
+	}
+
+	Solver solver(options);
+	for (int i = 0; i < 81 && clues > minClues; i++)
+	{
+		int cell = order[i];
+		int value = state.values[cell];
+		long long count = 0;
+		solveStats stats;
+
+		state.undo(cell);
+		if (solver.countSolutions(state, 2, count, budget, stats) == SolveResult::SOLVED && count == 1)
+		{
+			clues--;
+		}
+		else
+		{
+			state.place(cell, value);
+		}
+	}
+
+	state.store(puzzle);
+	return clues;
+}
+
+
+bool PuzzleGenerator::hasUniqueSolution(const int* puzzle)
+{
+	searchOptions options;
+	searchState state;
+	solveBudget budget;
+	solveStats stats;
+	long long count = 0;
+
+	options.cellOrder = CellOrder::MIN_CANDIDATES;
+	options.propagation = true;
+	budget.maxNodes = UNIQUENESS_NODE_BUDGET;
+
+	return state.load(puzzle) &&
+		Solver(options).countSolutions(state, 2, count, budget, stats) == SolveResult::SOLVED &&
+		count == 1;
+}
+
+
+std::uint64_t PuzzleGenerator::nextRandom()
+{
+	random_ ^= random_ << 13;
+	random_ ^= random_ >> 7;
+	random_ ^= random_ << 17;
+	return random_;
+}
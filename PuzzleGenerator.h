@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+#include "Solver.h"
+
+
+/*
+	Represents generator of random complete grids and puzzles
+	with unique solution
+*/
+class PuzzleGenerator
+{
+public:
+	/*
+		Creates generator with its own random sequence
+
+		@param seed Seed of the generator
+	*/
+	PuzzleGenerator(std::uint64_t seed);
+
+	/*
+		Generates random complete grid
+
+		@param grid Board where the grid is written
+	*/
+	void generateGrid(int* grid);
+
+	/*
+		Removes clues in random order while the puzzle keeps
+		unique solution
+
+		@param grid Complete grid
+		@param puzzle Board where the puzzle is written
+		@param minClues Count of clues where the removing stops
+		@return count of clues of the puzzle
+	*/
+	int removeClues(const int* grid, int* puzzle, int minClues);
+
+	/*
+		Checks if the puzzle has exactly one solution
+
+		@param puzzle Problem in row-major order
+		@return if the solution is unique
+	*/
+	static bool hasUniqueSolution(const int* puzzle);
+public:
+	const static long long UNIQUENESS_NODE_BUDGET;
+private:
+	/*
+		Get next random number
+
+		@return random number
+	*/
+	std::uint64_t nextRandom();
+private:
+	// Represents state of the random generator
+	std::uint64_t random_;
+};
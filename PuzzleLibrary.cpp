@@ -0,0 +1,410 @@
+#include "PuzzleLibrary.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include "PuzzleCanonical.h"
+
+const int PuzzleLibrary::INDEX_COUNT = 4;
+
+namespace
+{
+	const char MAGIC[8] = { 'S', 'U', 'D', 'O', 'K', 'L', 'I', 'B' };
+	const std::uint32_t VERSION = 1;
+
+	enum IndexKind
+	{
+		BY_DIFFICULTY, BY_CLUES, BY_TECHNIQUE, BY_HASH
+	};
+
+	// Represents beginning of the library file
+	struct libraryHeader
+	{
+		char magic[8];
+		std::uint32_t version;
+		std::uint32_t count;
+		// Offset of records followed by offsets of indexes
+		std::uint64_t offsets[5];
+		std::uint64_t reserved;
+	};
+
+	static_assert(sizeof(libraryRecord) == 64, "Record layout is part of the file format");
+	static_assert(sizeof(libraryHeader) == 64, "Header layout is part of the file format");
+
+	// Fills sort key of the record in the index
+	void getKey(const libraryRecord& record, int index, std::uint64_t* key)
+	{
+		switch (index)
+		{
+		case BY_DIFFICULTY:
+			key[0] = record.difficulty;
+			key[1] = record.clues;
+			key[2] = record.canonicalHash;
+			break;
+		case BY_CLUES:
+			key[0] = record.clues;
+			key[1] = record.difficulty;
+			key[2] = record.canonicalHash;
+			break;
+		case BY_TECHNIQUE:
+			key[0] = record.hardest;
+			key[1] = record.difficulty;
+			key[2] = record.clues;
+			break;
+		default:
+			key[0] = record.canonicalHash;
+			key[1] = 0;
+			key[2] = 0;
+		}
+	}
+
+	// Fills sort key of the record in the index, missing record is behind every record
+	void getKey(const libraryRecord* record, int index, std::uint64_t* key)
+	{
+		if (record == nullptr)
+		{
+			key[0] = UINT64_MAX;
+			key[1] = UINT64_MAX;
+			key[2] = UINT64_MAX;
+			return;
+		}
+
+		getKey(*record, index, key);
+	}
+
+	// Compares first length parts of the keys
+	int compareKeys(const std::uint64_t* first, const std::uint64_t* second, int length)
+	{
+		for (int i = 0; i < length; i++)
+		{
+			if (first[i] != second[i])
+			{
+				return first[i] < second[i] ? -1 : 1;
+			}
+		}
+
+		return 0;
+	}
+
+	bool matches(const libraryRecord* record, const libraryQuery& query)
+	{
+		return record != nullptr && (query.difficulty < 0 || record->difficulty == query.difficulty) &&
+			(query.clues < 0 || record->clues == query.clues) &&
+			(query.technique < 0 || record->hardest == query.technique);
+	}
+}
+
+
+PuzzleLibrary::PuzzleLibrary()
+{
+	records_ = nullptr;
+	count_ = 0;
+
+	for (int i = 0; i < INDEX_COUNT; i++)
+	{
+		indexes_[i] = nullptr;
+	}
+}
+
+
+PuzzleLibrary::~PuzzleLibrary()
+{
+}
+
+
+bool PuzzleLibrary::open(const std::string& filename)
+{
+	count_ = 0;
+
+	if (!file_.open(filename) || file_.getSize() < sizeof(libraryHeader))
+	{
+		return false;
+	}
+
+	const libraryHeader* header = reinterpret_cast<const libraryHeader*>(file_.getData());
+	if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION)
+	{
+		file_.close();
+		return false;
+	}
+
+	std::uint64_t size = file_.getSize();
+	std::uint64_t count = header->count;
+
+	if (count > static_cast<std::uint64_t>(INT_MAX) || header->offsets[0] % alignof(libraryRecord) != 0 ||
+		header->offsets[0] > size || count * sizeof(libraryRecord) > size - header->offsets[0])
+	{
+		file_.close();
+		return false;
+	}
+
+	for (int i = 0; i < INDEX_COUNT; i++)
+	{
+		std::uint64_t offset = header->offsets[1 + i];
+
+		if (offset % alignof(std::uint32_t) != 0 || offset > size || count * sizeof(std::uint32_t) > size - offset)
+		{
+			file_.close();
+			return false;
+		}
+
+		indexes_[i] = reinterpret_cast<const std::uint32_t*>(file_.getData() + offset);
+	}
+
+	// Index entries and cells aren't read here, so opening doesn't touch every page
+	records_ = reinterpret_cast<const libraryRecord*>(file_.getData() + header->offsets[0]);
+	count_ = static_cast<int>(count);
+
+	return true;
+}
+
+
+int PuzzleLibrary::getCount() const
+{
+	return count_;
+}
+
+
+const libraryRecord& PuzzleLibrary::getRecord(int index) const
+{
+	return records_[index];
+}
+
+
+bool PuzzleLibrary::getBoard(int index, int* board) const
+{
+	const libraryRecord& record = records_[index];
+	bool valid = true;
+
+	for (int cell = 0; cell < 81; cell++)
+	{
+		std::uint8_t packed = record.cells[cell / 2];
+		board[cell] = cell % 2 == 0 ? packed & 0x0F : packed >> 4;
+
+		if (board[cell] > 9)
+		{
+			board[cell] = 0;
+			valid = false;
+		}
+	}
+
+	return valid;
+}
+
+
+int PuzzleLibrary::count(const libraryQuery& query) const
+{
+	const std::uint32_t* first;
+	const std::uint32_t* last;
+
+	if (findRange(query, first, last))
+	{
+		return static_cast<int>(last - first);
+	}
+
+	return static_cast<int>(std::count_if(first, last, [this, &query](std::uint32_t index) {
+		return matches(getIndexed(index), query);
+	}));
+}
+
+
+int PuzzleLibrary::findRandom(const libraryQuery& query, std::mt19937& random) const
+{
+	const std::uint32_t* first;
+	const std::uint32_t* last;
+
+	if (findRange(query, first, last))
+	{
+		if (first == last)
+		{
+			return -1;
+		}
+
+		std::uniform_int_distribution<long long> distribution(0, last - first - 1);
+		std::uint32_t entry = first[distribution(random)];
+		return getIndexed(entry) != nullptr ? static_cast<int>(entry) : -1;
+	}
+
+	// Reservoir sampling of the range, every matching puzzle has the same chance
+	int found = -1;
+	int seen = 0;
+
+	for (const std::uint32_t* entry = first; entry != last; entry++)
+	{
+		if (matches(getIndexed(*entry), query) &&
+			std::uniform_int_distribution<int>(0, seen++)(random) == 0)
+		{
+			found = static_cast<int>(*entry);
+		}
+	}
+
+	return found;
+}
+
+
+int PuzzleLibrary::findByHash(std::uint64_t hash) const
+{
+	const std::uint32_t* index = indexes_[BY_HASH];
+	const std::uint32_t* entry = std::lower_bound(index, index + count_, hash,
+		[this](std::uint32_t record, std::uint64_t value) {
+			std::uint64_t key[3];
+			getKey(getIndexed(record), BY_HASH, key);
+			return key[0] < value;
+		});
+
+	if (entry == index + count_ || getIndexed(*entry) == nullptr || records_[*entry].canonicalHash != hash)
+	{
+		return -1;
+	}
+
+	return static_cast<int>(*entry);
+}
+
+
+bool PuzzleLibrary::findRange(const libraryQuery& query, const std::uint32_t*& first, const std::uint32_t*& last) const
+{
+	std::uint64_t prefix[3];
+	int length = 0;
+	int used = 0;
+	int index;
+
+	if (query.technique >= 0)
+	{
+		index = BY_TECHNIQUE;
+		prefix[length++] = static_cast<std::uint64_t>(query.technique);
+
+		if (query.difficulty >= 0)
+		{
+			prefix[length++] = static_cast<std::uint64_t>(query.difficulty);
+
+			if (query.clues >= 0)
+			{
+				prefix[length++] = static_cast<std::uint64_t>(query.clues);
+			}
+		}
+	}
+	else if (query.difficulty >= 0)
+	{
+		index = BY_DIFFICULTY;
+		prefix[length++] = static_cast<std::uint64_t>(query.difficulty);
+
+		if (query.clues >= 0)
+		{
+			prefix[length++] = static_cast<std::uint64_t>(query.clues);
+		}
+	}
+	else
+	{
+		index = BY_CLUES;
+
+		if (query.clues >= 0)
+		{
+			prefix[length++] = static_cast<std::uint64_t>(query.clues);
+		}
+	}
+
+	used += query.technique >= 0 ? 1 : 0;
+	used += query.difficulty >= 0 ? 1 : 0;
+	used += query.clues >= 0 ? 1 : 0;
+
+	first = indexes_[index];
+	last = indexes_[index] + count_;
+
+	if (length > 0)
+	{
+		first = std::lower_bound(first, last, prefix, [this, index, length](std::uint32_t record, const std::uint64_t* value) {
+			std::uint64_t key[3];
+			getKey(getIndexed(record), index, key);
+			return compareKeys(key, value, length) < 0;
+		});
+		last = std::upper_bound(first, last, prefix, [this, index, length](const std::uint64_t* value, std::uint32_t record) {
+			std::uint64_t key[3];
+			getKey(getIndexed(record), index, key);
+			return compareKeys(value, key, length) < 0;
+		});
+	}
+
+	return length == used;
+}
+
+
+const libraryRecord* PuzzleLibrary::getIndexed(std::uint32_t entry) const
+{
+	return entry < static_cast<std::uint32_t>(count_) ? records_ + entry : nullptr;
+}
+
+
+libraryRecord PuzzleLibrary::createRecord(const int* board)
+{
+	return createRecord(board, PuzzleRating::rate(board), PuzzleCanonical::getCanonicalHash(board));
+}
+
+
+libraryRecord PuzzleLibrary::createRecord(const int* board, const puzzleRating& rating, std::uint64_t canonicalHash)
+{
+	libraryRecord record;
+
+	memset(&record, 0, sizeof(record));
+	record.canonicalHash = canonicalHash;
+	record.nodes = static_cast<std::uint32_t>(std::min<long long>(rating.nodes, UINT32_MAX));
+	record.techniques = rating.techniques;
+	record.clues = static_cast<std::uint8_t>(rating.clues);
+	record.difficulty = static_cast<std::uint8_t>(rating.difficulty);
+	record.hardest = static_cast<std::uint8_t>(rating.hardest);
+
+	for (int cell = 0; cell < 81; cell++)
+	{
+		record.cells[cell / 2] |= static_cast<std::uint8_t>(board[cell] << (cell % 2 == 0 ? 0 : 4));
+	}
+
+	return record;
+}
+
+
+bool PuzzleLibrary::write(const std::string& filename, const std::vector<libraryRecord>& records)
+{
+	libraryHeader header;
+	std::uint32_t count = static_cast<std::uint32_t>(records.size());
+	std::uint64_t indexSize = count * sizeof(std::uint32_t);
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.count = count;
+	header.offsets[0] = sizeof(libraryHeader);
+
+	for (int i = 0; i < INDEX_COUNT; i++)
+	{
+		header.offsets[1 + i] = sizeof(libraryHeader) + count * sizeof(libraryRecord) + i * indexSize;
+	}
+
+	std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(records.data()), count * sizeof(libraryRecord));
+
+	std::vector<std::uint32_t> index(count);
+	for (int kind = 0; kind < INDEX_COUNT; kind++)
+	{
+		for (std::uint32_t i = 0; i < count; i++)
+		{
+			index[i] = i;
+		}
+
+		std::sort(index.begin(), index.end(), [&records, kind](std::uint32_t first, std::uint32_t second) {
+			std::uint64_t firstKey[3];
+			std::uint64_t secondKey[3];
+			getKey(records[first], kind, firstKey);
+			getKey(records[second], kind, secondKey);
+			return compareKeys(firstKey, secondKey, 3) < 0;
+		});
+
+		file.write(reinterpret_cast<const char*>(index.data()), indexSize);
+	}
+
+	return file.good();
+}
@@ -0,0 +1,177 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+#include "PuzzleRating.h"
+
+
+/*
+	Represents one puzzle with precomputed metadata, the layout
+	is stored in the library file as it is
+*/
+struct libraryRecord
+{
+	// Hash of the canonical form
+	std::uint64_t canonicalHash;
+	// Count of search nodes if guessing is needed
+	std::uint32_t nodes;
+	// Bitmask of needed techniques
+	std::uint16_t techniques;
+	// Count of given numbers
+	std::uint8_t clues;
+	// Difficulty of the puzzle
+	std::uint8_t difficulty;
+	// The hardest needed technique
+	std::uint8_t hardest;
+	// Cells packed by two into one byte, the first cell in the lower half
+	std::uint8_t cells[41];
+	std::uint8_t reserved[6];
+};
+
+
+/*
+	Represents query to the library, negative value means any
+*/
+struct libraryQuery
+{
+	int difficulty = -1;
+	int clues = -1;
+	int technique = -1;
+};
+
+
+/*
+	Represents memory-mapped file with puzzles sorted by
+	secondary indexes, every query is binary search
+
+	File layout: header, records, index by difficulty and clues,
+	index by clues and difficulty, index by the hardest technique,
+	difficulty and clues, index by canonical hash
+*/
+class PuzzleLibrary
+{
+public:
+	PuzzleLibrary();
+	~PuzzleLibrary();
+
+	/*
+		Opens the library file, only the header and the bounds of
+		records and indexes are checked, index entries are checked
+		when queries read them
+
+		@param filename Name of the file
+		@return if the file is valid library
+	*/
+	bool open(const std::string& filename);
+
+	/*
+		Get count of puzzles
+
+		@return count of puzzles
+	*/
+	int getCount() const;
+
+	/*
+		Get record of the puzzle
+
+		@param index Index of the puzzle
+		@return record of the puzzle
+	*/
+	const libraryRecord& getRecord(int index) const;
+
+	/*
+		Unpacks problem of the puzzle, cells are checked here so
+		opening doesn't have to read every record
+
+		@param index Index of the puzzle
+		@param board Board of 81 numbers in row-major order
+		@return if every cell has value 0..9
+	*/
+	bool getBoard(int index, int* board) const;
+
+	/*
+		Counts puzzles matching the query
+
+		@param query Query
+		@return count of matching puzzles
+	*/
+	int count(const libraryQuery& query) const;
+
+	/*
+		Finds random puzzle matching the query, it's O(log n) if the
+		query fits prefix of some index, otherwise the index range is
+		filtered
+
+		@param query Query
+		@param random Random generator
+		@return index of the puzzle or -1 if no puzzle matches
+	*/
+	int findRandom(const libraryQuery& query, std::mt19937& random) const;
+
+	/*
+		Finds puzzle with the canonical hash
+
+		@param hash Canonical hash
+		@return index of the puzzle or -1 if it isn't in library
+	*/
+	int findByHash(std::uint64_t hash) const;
+
+	/*
+		Creates record of the problem with rating and canonical hash
+
+		@param board Problem in row-major order
+		@return record of the problem
+	*/
+	static libraryRecord createRecord(const int* board);
+
+	/*
+		Creates record of the problem from known metadata
+
+		@param board Problem in row-major order
+		@param rating Rating of the problem
+		@param canonicalHash Hash of the canonical form
+		@return record of the problem
+	*/
+	static libraryRecord createRecord(const int* board, const puzzleRating& rating, std::uint64_t canonicalHash);
+
+	/*
+		Writes records with indexes into the file
+
+		@param filename Name of the file
+		@param records Records of puzzles
+		@return if the file was written
+	*/
+	static bool write(const std::string& filename, const std::vector<libraryRecord>& records);
+public:
+	const static int INDEX_COUNT;
+private:
+	/*
+		Finds range of index entries whose key starts with values
+		of the query
+
+		@param query Query
+		@param first First entry of the range
+		@param last Entry behind the range
+		@return if the query is fully covered by the key prefix
+	*/
+	bool findRange(const libraryQuery& query, const std::uint32_t*& first, const std::uint32_t*& last) const;
+
+	/*
+		Get record referenced by index entry
+
+		@param entry Value of the index entry
+		@return record or nullptr if the entry points outside of records
+	*/
+	const libraryRecord* getIndexed(std::uint32_t entry) const;
+private:
+	// Represents mapped library file
+	MappedFile file_;
+	// Represents records in the mapped file
+	const libraryRecord* records_;
+	// Represents indexes in the mapped file
+	const std::uint32_t* indexes_[4];
+	// Represents count of puzzles
+	int count_;
+};
@@ -0,0 +1,123 @@
+#include "PuzzleRating.h"
+#include "Solver.h"
+
+namespace
+{
+	// Represents score of one round of every technique, the guessing adds cells left after logic
+	const long long NAKED_SINGLE_SCORE = 1;
+	const long long HIDDEN_SINGLE_SCORE = 3;
+	const long long LOCKED_CANDIDATES_SCORE = 10;
+	const long long GUESSING_SCORE = 200;
+
+	// Represents the lowest score that isn't EASY, MEDIUM and HARD
+	const long long DIFFICULTY_SCORES[3] = { 15, 45, 200 };
+
+	// Represents budget of the search that counts nodes of the guessing
+	const long long GUESSING_NODES = 1000000;
+}
+
+
+puzzleRating PuzzleRating::rate(const int* board)
+{
+	puzzleRating rating = puzzleRating();
+	searchState logic;
+	std::uint16_t eliminated[81] = { 0 };
+	int placed[81];
+	int count;
+	Deduction deduction;
+
+	logic.load(board);
+	rating.clues = 81 - logic.emptyCount;
+
+	// Solver::propagate takes the same steps, so rating can't drift from the solver
+	while ((deduction = Solver::deduce(logic, eliminated, placed, count)) != Deduction::NONE &&
+		deduction != Deduction::CONTRADICTION)
+	{
+		switch (deduction)
+		{
+		case Deduction::NAKED_SINGLES:
+			rating.techniques |= 1 << static_cast<int>(Technique::NAKED_SINGLE);
+			rating.score += NAKED_SINGLE_SCORE;
+			break;
+		case Deduction::HIDDEN_SINGLES:
+			rating.techniques |= 1 << static_cast<int>(Technique::HIDDEN_SINGLE);
+			rating.score += HIDDEN_SINGLE_SCORE;
+			break;
+		default:
+			rating.techniques |= 1 << static_cast<int>(Technique::LOCKED_CANDIDATES);
+			rating.score += LOCKED_CANDIDATES_SCORE;
+		}
+	}
+
+	if (logic.emptyCount > 0)
+	{
+		searchOptions options;
+		solveBudget budget;
+		solveStats stats;
+
+		// Cells left after logic don't change with symmetries of the puzzle, nodes of
+		// the search do, so they are only reported
+		rating.score += GUESSING_SCORE + logic.emptyCount;
+		rating.techniques |= 1 << static_cast<int>(Technique::GUESSING);
+
+		options.cellOrder = CellOrder::MIN_CANDIDATES;
+		options.propagation = true;
+		budget.maxNodes = GUESSING_NODES;
+		Solver(options).solve(logic, budget, stats);
+		rating.nodes = stats.nodes;
+	}
+
+	rating.hardest = Technique::NAKED_SINGLE;
+	for (int technique = 0; technique <= static_cast<int>(Technique::GUESSING); technique++)
+	{
+		if (rating.techniques & (1 << technique))
+		{
+			rating.hardest = static_cast<Technique>(technique);
+		}
+	}
+
+	rating.difficulty = Difficulty::EXPERT;
+	for (int difficulty = 0; difficulty < static_cast<int>(Difficulty::EXPERT); difficulty++)
+	{
+		if (rating.score < DIFFICULTY_SCORES[difficulty])
+		{
+			rating.difficulty = static_cast<Difficulty>(difficulty);
+			break;
+		}
+	}
+
+	return rating;
+}
+
+
+const char* PuzzleRating::getName(Difficulty difficulty)
+{
+	switch (difficulty)
+	{
+	case Difficulty::EASY:
+		return "easy";
+	case Difficulty::MEDIUM:
+		return "medium";
+	case Difficulty::HARD:
+		return "hard";
+	default:
+		return "expert";
+	}
+}
+
+
+const char* PuzzleRating::getName(Technique technique)
+{
+	switch (technique)
+	{
+	case Technique::NAKED_SINGLE:
+		return "naked-single";
+	case Technique::HIDDEN_SINGLE:
+		return "hidden-single";
+	case Technique::LOCKED_CANDIDATES:
+		return "locked-candidates";
+	default:
+		return "guessing";
+	}
+}
+
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstdint>
+
+
+/*
+	Represents solving techniques ordered from the easiest
+*/
+enum class Technique
+{
+	NAKED_SINGLE, HIDDEN_SINGLE, LOCKED_CANDIDATES, GUESSING
+};
+
+
+/*
+	Represents difficulty of the puzzle
+*/
+enum class Difficulty
+{
+	EASY, MEDIUM, HARD, EXPERT
+};
+
+
+/*
+	Represents result of the rating
+*/
+struct puzzleRating
+{
+	// Bitmask of needed techniques, bit n represents Technique n
+	std::uint16_t techniques;
+	// The hardest needed technique
+	Technique hardest;
+	// Difficulty derived from the score
+	Difficulty difficulty;
+	// Weighted count of rounds of techniques and cells left for guessing,
+	// rounds of harder techniques weigh more, it doesn't change with
+	// symmetries of the puzzle
+	long long score;
+	// Count of given numbers
+	int clues;
+	// Count of nodes of the min-candidates search after logic if guessing
+	// is needed, it isn't part of the score
+	long long nodes;
+};
+
+
+/*
+	Represents rating of puzzles by techniques that a human
+	solver needs
+*/
+class PuzzleRating
+{
+public:
+	/*
+		Rates the puzzle, the easiest technique that makes progress
+		is always applied first and to every cell at once, so the
+		rating is the same for every symmetry of the puzzle
+
+		@param board Problem in row-major order
+		@return Rating of the puzzle
+	*/
+	static puzzleRating rate(const int* board);
+
+	/*
+		Get name of the difficulty
+
+		@param difficulty Difficulty
+		@return name of the difficulty
+	*/
+	static const char* getName(Difficulty difficulty);
+
+	/*
+		Get name of the technique
+
+		@param technique Technique
+		@return name of the technique
+	*/
+	static const char* getName(Technique technique);
+};
@@ -0,0 +1,229 @@
+#include "PuzzleReducer.h"
+#include <algorithm>
+#include <cstring>
+
+const long long PuzzleReducer::CHECK_NODE_BUDGET = 1000000;
+
+
+PuzzleReducer::PuzzleReducer(int threads)
+{
+	round_ = 0;
+	finishedCount_ = 0;
+	stopping_ = false;
+	next_ = 0;
+	nodes_ = 0;
+
+	for (int i = 1; i < threads; i++)
+	{
+		workers_.emplace_back(&PuzzleReducer::work, this);
+	}
+}
+
+
+PuzzleReducer::~PuzzleReducer()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stopping_ = true;
+	}
+
+	started_.notify_all();
+
+	for (auto& worker : workers_)
+	{
+		worker.join();
+	}
+}
+
+
+minimalityReport PuzzleReducer::check(const int* puzzle)
+{
+	auto start = std::chrono::steady_clock::now();
+	minimalityReport report;
+	searchOptions options;
+	searchState state;
+	solveBudget budget;
+	solveStats stats;
+	long long count = 0;
+
+	memset(&report, 0, sizeof(report));
+	options.cellOrder = CellOrder::MIN_CANDIDATES;
+	options.propagation = true;
+	budget.maxNodes = CHECK_NODE_BUDGET;
+	report.unique = state.load(puzzle) &&
+		Solver(options).countSolutions(state, 2, count, budget, stats) == SolveResult::SOLVED && count == 1;
+	report.nodes = stats.nodes;
+
+	memcpy(puzzle_, puzzle, sizeof(puzzle_));
+	candidates_.clear();
+
+	for (int cell = 0; cell < 81; cell++)
+	{
+		if (puzzle[cell] != 0)
+		{
+			report.clues++;
+			candidates_.push_back(cell);
+		}
+	}
+
+	if (report.unique)
+	{
+		runRound();
+
+		for (size_t i = 0; i < candidates_.size(); i++)
+		{
+			report.redundant[candidates_[i]] = results_[i] == 1;
+			report.redundantCount += results_[i] == 1 ? 1 : 0;
+			report.undecided += results_[i] < 0 ? 1 : 0;
+		}
+
+		report.nodes += nodes_;
+	}
+
+	report.elapsedMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now() - start).count();
+
+	return report;
+}
+
+
+minimalityReport PuzzleReducer::reduce(const int* puzzle, int* minimal)
+{
+	auto start = std::chrono::steady_clock::now();
+	minimalityReport report = check(puzzle);
+	long long nodes = report.nodes;
+
+	memcpy(minimal, puzzle, sizeof(puzzle_));
+	if (!report.unique)
+	{
+		return report;
+	}
+
+	std::vector<int> pending;
+	for (int cell = 0; cell < 81; cell++)
+	{
+		if (report.redundant[cell])
+		{
+			pending.push_back(cell);
+		}
+	}
+
+	// Every thread checks one of the next pending clues against the current puzzle, the first
+	// redundant one is removed, clues before it and necessary clues behind it are decided for good
+	size_t batchSize = workers_.size() + 1;
+	while (!pending.empty())
+	{
+		memcpy(puzzle_, minimal, sizeof(puzzle_));
+		candidates_.assign(pending.begin(), pending.begin() + std::min(batchSize, pending.size()));
+
+		runRound();
+		nodes += nodes_;
+
+		std::vector<int> undecided;
+		bool removed = false;
+
+		for (size_t i = 0; i < candidates_.size(); i++)
+		{
+			if (results_[i] == 1 && !removed)
+			{
+				minimal[candidates_[i]] = 0;
+				removed = true;
+			}
+			else if (results_[i] == 1)
+			{
+				undecided.push_back(candidates_[i]);
+			}
+		}
+
+		undecided.insert(undecided.end(), pending.begin() + candidates_.size(), pending.end());
+		pending.swap(undecided);
+	}
+
+	report = check(minimal);
+	report.nodes += nodes;
+	report.elapsedMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now() - start).count();
+
+	return report;
+}
+
+
+void PuzzleReducer::checkCandidates()
+{
+	searchOptions options;
+	searchState state;
+	solveBudget budget;
+	solveStats stats;
+	int index;
+
+	options.cellOrder = CellOrder::MIN_CANDIDATES;
+	options.propagation = true;
+	budget.maxNodes = CHECK_NODE_BUDGET;
+	state.load(puzzle_);
+
+	Solver solver(options);
+
+	while ((index = next_.fetch_add(1)) < static_cast<int>(candidates_.size()))
+	{
+		int cell = candidates_[index];
+		int value = state.values[cell];
+		long long count = 0;
+		solveStats checkStats;
+
+		state.undo(cell);
+		SolveResult result = solver.countSolutions(state, 2, count, budget, checkStats);
+		state.place(cell, value);
+
+		results_[index] = result == SolveResult::BUDGET_EXHAUSTED ? -1 : (count == 1 ? 1 : 0);
+		stats.nodes += checkStats.nodes;
+	}
+
+	nodes_ += stats.nodes;
+}
+
+
+void PuzzleReducer::runRound()
+{
+	results_.assign(candidates_.size(), 0);
+	next_ = 0;
+	nodes_ = 0;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		finishedCount_ = 0;
+		round_++;
+	}
+
+	started_.notify_all();
+	checkCandidates();
+
+	std::unique_lock<std::mutex> lock(mutex_);
+	finished_.wait(lock, [this] { return finishedCount_ == static_cast<int>(workers_.size()); });
+}
+
+
+void PuzzleReducer::work()
+{
+	long long round = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			started_.wait(lock, [this, round] { return stopping_ || round_ != round; });
+
+			if (stopping_)
+			{
+				return;
+			}
+
+			round = round_;
+		}
+
+		checkCandidates();
+
+		std::lock_guard<std::mutex> lock(mutex_);
+		finishedCount_++;
+		finished_.notify_all();
+	}
+}
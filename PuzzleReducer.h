@@ -0,0 +1,112 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Solver.h"
+
+
+/*
+	Represents which clues of the puzzle are necessary
+*/
+struct minimalityReport
+{
+	// If the puzzle has exactly one solution, other fields are valid only then
+	bool unique;
+	// Count of clues
+	int clues;
+	// Count of clues that can be removed alone and the solution stays unique
+	int redundantCount;
+	// Redundant clues in row-major order
+	bool redundant[81];
+	// Count of checks out of budget, their clues are treated as necessary
+	int undecided;
+	// Count of search nodes of all checks
+	long long nodes;
+	// Duration in microseconds
+	long long elapsedMicroseconds;
+};
+
+
+/*
+	Represents checker and reducer of puzzles that runs uniqueness
+	checks of clues on pool of threads, every thread loads the puzzle
+	once per round and only removes and puts back the checked clue
+*/
+class PuzzleReducer
+{
+public:
+	/*
+		Creates reducer with its own threads
+
+		@param threads Count of threads including the calling thread
+	*/
+	PuzzleReducer(int threads);
+	~PuzzleReducer();
+
+	/*
+		Checks every clue of the puzzle
+
+		@param puzzle Problem in row-major order
+		@return report of necessary and redundant clues
+	*/
+	minimalityReport check(const int* puzzle);
+
+	/*
+		Removes clues in row-major order while the solution stays
+		unique, the result is minimal and the same as removing clues
+		one by one, threads check the next clues speculatively and
+		only redundant clues behind the removed one are checked again
+		because necessary clues stay necessary after any removal
+
+		@param puzzle Problem with unique solution in row-major order
+		@param minimal Board where the minimal puzzle is written
+		@return report of the minimal puzzle, it isn't unique if the
+			input wasn't
+	*/
+	minimalityReport reduce(const int* puzzle, int* minimal);
+public:
+	const static long long CHECK_NODE_BUDGET;
+private:
+	/*
+		Checks candidates of the round on the calling thread
+	*/
+	void checkCandidates();
+
+	/*
+		Checks all candidates on every thread and waits for them
+	*/
+	void runRound();
+
+	/*
+		Represents loop of the pool thread
+	*/
+	void work();
+private:
+	// Represents pool threads
+	std::vector<std::thread> workers_;
+	// Represents lock of the round
+	std::mutex mutex_;
+	// Represents signal of new round or stopping
+	std::condition_variable started_;
+	// Represents signal of finished thread
+	std::condition_variable finished_;
+	// Represents number of the current round
+	long long round_;
+	// Represents count of pool threads that finished the round
+	int finishedCount_;
+	// Represents if pool threads have to end
+	bool stopping_;
+
+	// Represents puzzle of the round
+	int puzzle_[81];
+	// Represents clues checked in the round
+	std::vector<int> candidates_;
+	// Represents result of every candidate, 1 if it's redundant and -1 if undecided
+	std::vector<int> results_;
+	// Represents index of the next unchecked candidate
+	std::atomic<int> next_;
+	// Represents nodes of the round
+	std::atomic<long long> nodes_;
+};
@@ -0,0 +1,382 @@
+#include "PuzzleRules.h"
+#include <cstring>
+
+const int PuzzleRules::MAX_UNITS;
+const int PuzzleRules::MAX_UNITS_OF_CELL;
+const int PuzzleRules::MAX_PEERS;
+
+namespace
+{
+	const std::uint16_t ALL_VALUES = 0x3FE;
+	const int MAX_SUM = 45;
+
+	// Represents every set of distinct values grouped by count and sum of values
+	struct combinationTable
+	{
+		std::uint16_t masks[512];
+		int first[10][MAX_SUM + 2];
+
+		combinationTable()
+		{
+			int counts[10][MAX_SUM + 1] = { { 0 } };
+
+			for (int set = 0; set < 512; set++)
+			{
+				counts[getCount(set)][getSum(set)]++;
+			}
+
+			int next = 0;
+			for (int count = 0; count < 10; count++)
+			{
+				for (int sum = 0; sum <= MAX_SUM; sum++)
+				{
+					first[count][sum] = next;
+					next += counts[count][sum];
+				}
+
+				first[count][MAX_SUM + 1] = next;
+			}
+
+			int filled[10][MAX_SUM + 1] = { { 0 } };
+			for (int set = 0; set < 512; set++)
+			{
+				int count = getCount(set);
+				int sum = getSum(set);
+
+				masks[first[count][sum] + filled[count][sum]++] = static_cast<std::uint16_t>(set << 1);
+			}
+		}
+
+		static int getCount(int set)
+		{
+			int count = 0;
+
+			for (; set != 0; set &= set - 1)
+			{
+				count++;
+			}
+
+			return count;
+		}
+
+		static int getSum(int set)
+		{
+			int sum = 0;
+
+			for (int value = 1; value <= 9; value++)
+			{
+				if (set & (1 << (value - 1)))
+				{
+					sum += value;
+				}
+			}
+
+			return sum;
+		}
+	};
+
+	const combinationTable COMBINATIONS;
+
+	// Computes index of the 3x3 box of the cell
+	int getBox(int cell)
+	{
+		return (cell / 27) * 3 + (cell % 9) / 3;
+	}
+}
+
+
+PuzzleRules::PuzzleRules()
+{
+	reset();
+}
+
+
+void PuzzleRules::reset()
+{
+	unitCount_ = 0;
+	irregular_ = false;
+	diagonals_ = false;
+	memset(unitCountOfCell_, 0, sizeof(unitCountOfCell_));
+
+	for (int kind = 0; kind < 3; kind++)
+	{
+		for (int unit = 0; unit < 9; unit++)
+		{
+			int cells[9];
+
+			for (int i = 0; i < 9; i++)
+			{
+				switch (kind)
+				{
+				case 0:
+					cells[i] = unit * 9 + i;
+					break;
+				case 1:
+					cells[i] = i * 9 + unit;
+					break;
+				default:
+					cells[i] = (unit / 3) * 27 + (unit % 3) * 3 + (i / 3) * 9 + i % 3;
+				}
+			}
+
+			addUnit(kind == 0 ? UnitKind::ROW : kind == 1 ? UnitKind::COLUMN : UnitKind::BOX, cells, 9, 0);
+		}
+	}
+
+	for (int cell = 0; cell < 81; cell++)
+	{
+		regionOfCell_[cell] = static_cast<std::uint8_t>(getBox(cell));
+	}
+
+	compile();
+}
+
+
+void PuzzleRules::addDiagonals()
+{
+	if (diagonals_)
+	{
+		return;
+	}
+
+	int leading[9];
+	int anti[9];
+
+	for (int i = 0; i < 9; i++)
+	{
+		leading[i] = i * 10;
+		anti[i] = (i + 1) * 8;
+	}
+
+	addUnit(UnitKind::DIAGONAL, leading, 9, 0);
+	addUnit(UnitKind::DIAGONAL, anti, 9, 0);
+	diagonals_ = true;
+	compile();
+}
+
+
+bool PuzzleRules::setRegions(const int* regions)
+{
+	int sizes[9] = { 0 };
+	int cells[9][9];
+
+	for (int cell = 0; cell < 81; cell++)
+	{
+		int region = regions[cell];
+
+		if (region < 0 || region >= 9 || sizes[region] >= 9)
+		{
+			return false;
+		}
+
+		cells[region][sizes[region]++] = cell;
+	}
+
+	// Boxes are units 18..26 and every cell has them on the third place
+	for (int region = 0; region < 9; region++)
+	{
+		ruleUnit& unit = units_[18 + region];
+
+		unit.kind = UnitKind::REGION;
+		for (int i = 0; i < 9; i++)
+		{
+			int cell = cells[region][i];
+
+			unit.cells[i] = static_cast<std::uint8_t>(cell);
+			unitsOfCell_[cell][2] = static_cast<std::uint8_t>(18 + region);
+			regionOfCell_[cell] = static_cast<std::uint8_t>(region);
+		}
+	}
+
+	irregular_ = true;
+	compile();
+	return true;
+}
+
+
+bool PuzzleRules::addCage(const int* cells, int size, int sum)
+{
+	if (size < 1 || size > 9 || unitCount_ >= MAX_UNITS ||
+		sum < 1 || sum > MAX_SUM || getCombinationMask(size, sum, 0) == 0)
+	{
+		return false;
+	}
+
+	for (int i = 0; i < size; i++)
+	{
+		if (cells[i] < 0 || cells[i] >= 81 || cageOfCell_[cells[i]] >= 0)
+		{
+			return false;
+		}
+
+		for (int j = 0; j < i; j++)
+		{
+			if (cells[i] == cells[j])
+			{
+				return false;
+			}
+		}
+	}
+
+	addUnit(UnitKind::CAGE, cells, size, sum);
+	compile();
+	return true;
+}
+
+
+bool PuzzleRules::isClassic() const
+{
+	return unitCount_ == 27 && !irregular_;
+}
+
+
+bool PuzzleRules::hasDiagonals() const
+{
+	return diagonals_;
+}
+
+
+int PuzzleRules::getUnitCount() const
+{
+	return unitCount_;
+}
+
+
+const ruleUnit& PuzzleRules::getUnit(int unit) const
+{
+	return units_[unit];
+}
+
+
+int PuzzleRules::getUnitCountOfCell(int cell) const
+{
+	return unitCountOfCell_[cell];
+}
+
+
+const std::uint8_t* PuzzleRules::getUnitsOfCell(int cell) const
+{
+	return unitsOfCell_[cell];
+}
+
+
+int PuzzleRules::getPeerCount(int cell) const
+{
+	return peerCount_[cell];
+}
+
+
+const std::uint8_t* PuzzleRules::getPeers(int cell) const
+{
+	return peers_[cell];
+}
+
+
+int PuzzleRules::getRegionOfCell(int cell) const
+{
+	return regionOfCell_[cell];
+}
+
+
+int PuzzleRules::getCageOfCell(int cell) const
+{
+	return cageOfCell_[cell];
+}
+
+
+std::uint16_t PuzzleRules::getCellMask(int cell) const
+{
+	return cellMasks_[cell];
+}
+
+
+std::uint16_t PuzzleRules::getCageCandidates(int cage, std::uint16_t used, int usedSum) const
+{
+	const ruleUnit& unit = units_[cage];
+	int placed = 0;
+
+	for (std::uint16_t mask = used; mask != 0; mask &= mask - 1)
+	{
+		placed++;
+	}
+
+	return getCombinationMask(unit.size - placed, unit.sum - usedSum, used);
+}
+
+
+std::uint16_t PuzzleRules::getCombinationMask(int count, int sum, std::uint16_t excluded)
+{
+	if (count < 0 || count > 9 || sum < 0 || sum > MAX_SUM)
+	{
+		return 0;
+	}
+
+	std::uint16_t mask = 0;
+	const std::uint16_t* set = COMBINATIONS.masks + COMBINATIONS.first[count][sum];
+	const std::uint16_t* last = COMBINATIONS.masks + COMBINATIONS.first[count][sum + 1];
+
+	for (; set != last; set++)
+	{
+		if (!(*set & excluded))
+		{
+			mask |= *set;
+		}
+	}
+
+	return mask;
+}
+
+
+void PuzzleRules::addUnit(UnitKind kind, const int* cells, int size, int sum)
+{
+	ruleUnit& unit = units_[unitCount_];
+
+	unit.kind = kind;
+	unit.size = size;
+	unit.sum = sum;
+
+	for (int i = 0; i < size; i++)
+	{
+		unit.cells[i] = static_cast<std::uint8_t>(cells[i]);
+		unitsOfCell_[cells[i]][unitCountOfCell_[cells[i]]++] = static_cast<std::uint8_t>(unitCount_);
+	}
+
+	unitCount_++;
+}
+
+
+void PuzzleRules::compile()
+{
+	for (int cell = 0; cell < 81; cell++)
+	{
+		bool peer[81] = { false };
+		int count = 0;
+
+		cageOfCell_[cell] = -1;
+		cellMasks_[cell] = ALL_VALUES;
+
+		for (int i = 0; i < unitCountOfCell_[cell]; i++)
+		{
+			const ruleUnit& unit = units_[unitsOfCell_[cell][i]];
+
+			if (unit.kind == UnitKind::CAGE)
+			{
+				cageOfCell_[cell] = static_cast<std::int8_t>(unitsOfCell_[cell][i]);
+				cellMasks_[cell] = getCombinationMask(unit.size, unit.sum, 0);
+			}
+
+			for (int j = 0; j < unit.size; j++)
+			{
+				int other = unit.cells[j];
+
+				if (other != cell && !peer[other])
+				{
+					peer[other] = true;
+					peers_[cell][count++] = static_cast<std::uint8_t>(other);
+				}
+			}
+		}
+
+		peerCount_[cell] = static_cast<std::uint8_t>(count);
+	}
+}
@@ -0,0 +1,227 @@
+#pragma once
+#include <cstdint>
+
+
+/*
+	Represents kind of the unit
+*/
+enum class UnitKind
+{
+	ROW, COLUMN, BOX, REGION, DIAGONAL, CAGE
+};
+
+
+/*
+	Represents group of cells where every value can be used
+	at most once, cages also have sum of their values
+*/
+struct ruleUnit
+{
+	// Kind of the unit
+	UnitKind kind;
+	// Count of cells in the unit
+	int size;
+	// Sum of values in the cage, 0 if the unit has no sum
+	int sum;
+	// Indexes of cells in row-major order
+	std::uint8_t cells[9];
+};
+
+
+/*
+	Represents rules of one puzzle compiled into flat tables, the
+	classic rules are rows, columns and 3x3 boxes, variants add
+	diagonals, replace boxes by irregular regions or add killer
+	cages, the tables are rebuilt after every change so checking
+	the rules is only reading of the tables
+*/
+class PuzzleRules
+{
+public:
+	/*
+		Creates classic rules
+	*/
+	PuzzleRules();
+
+	/*
+		Restores classic rules
+	*/
+	void reset();
+
+	/*
+		Adds both main diagonals as units
+	*/
+	void addDiagonals();
+
+	/*
+		Replaces boxes by irregular regions
+
+		@param regions Index of region 0..8 for every cell
+		@return if every region has 9 cells, otherwise nothing is changed
+	*/
+	bool setRegions(const int* regions);
+
+	/*
+		Adds killer cage, values in the cage can't repeat and
+		their sum has to be equal to the given sum
+
+		@param cells Indexes of cells in the cage
+		@param size Count of cells 1..9
+		@param sum Sum of values in the cage
+		@return if the cage is valid and its cells aren't in other cage
+	*/
+	bool addCage(const int* cells, int size, int sum);
+
+	/*
+		Checks if the rules are classic rules
+
+		@return if there are no diagonals, regions or cages
+	*/
+	bool isClassic() const;
+
+	/*
+		Checks if the rules have diagonals
+
+		@return if the diagonals are units
+	*/
+	bool hasDiagonals() const;
+
+	/*
+		Get count of units
+
+		@return count of units
+	*/
+	int getUnitCount() const;
+
+	/*
+		Get unit with specific index
+
+		@param unit Index of the unit
+		@return unit
+	*/
+	const ruleUnit& getUnit(int unit) const;
+
+	/*
+		Get count of units that contain the cell
+
+		@param cell Index of the cell
+		@return count of units
+	*/
+	int getUnitCountOfCell(int cell) const;
+
+	/*
+		Get indexes of units that contain the cell
+
+		@param cell Index of the cell
+		@return array of getUnitCountOfCell indexes
+	*/
+	const std::uint8_t* getUnitsOfCell(int cell) const;
+
+	/*
+		Get count of cells sharing any unit with the cell
+
+		@param cell Index of the cell
+		@return count of peers
+	*/
+	int getPeerCount(int cell) const;
+
+	/*
+		Get cells sharing any unit with the cell
+
+		@param cell Index of the cell
+		@return array of getPeerCount indexes
+	*/
+	const std::uint8_t* getPeers(int cell) const;
+
+	/*
+		Get index of region or box of the cell
+
+		@param cell Index of the cell
+		@return index of region 0..8
+	*/
+	int getRegionOfCell(int cell) const;
+
+	/*
+		Get unit of the cage containing the cell
+
+		@param cell Index of the cell
+		@return index of the unit or -1 if the cell isn't in cage
+	*/
+	int getCageOfCell(int cell) const;
+
+	/*
+		Get values allowed in the cell by sums of cages when the
+		board is empty
+
+		@param cell Index of the cell
+		@return Bitmask of values, bit 1 represents value 1
+	*/
+	std::uint16_t getCellMask(int cell) const;
+
+	/*
+		Get values that can still be placed into cage
+
+		@param cage Index of the cage unit
+		@param used Bitmask of values already placed in the cage
+		@param usedSum Sum of values already placed in the cage
+		@return Bitmask of values that are part of some combination
+			completing the sum of the cage
+	*/
+	std::uint16_t getCageCandidates(int cage, std::uint16_t used, int usedSum) const;
+
+	/*
+		Get union of every set of distinct values with specific
+		count and sum that doesn't contain excluded values
+
+		@param count Count of values 0..9
+		@param sum Sum of values
+		@param excluded Bitmask of values that can't be used
+		@return Bitmask of values
+	*/
+	static std::uint16_t getCombinationMask(int count, int sum, std::uint16_t excluded);
+public:
+	// 27 houses, 2 diagonals and cages with one cell in the worst case
+	const static int MAX_UNITS = 110;
+	// Row, column, box, both diagonals and cage
+	const static int MAX_UNITS_OF_CELL = 6;
+	// Every unit of the cell adds at most 8 peers
+	const static int MAX_PEERS = 48;
+private:
+	/*
+		Adds unit and registers it in cells
+
+		@param kind Kind of the unit
+		@param cells Indexes of cells in the unit
+		@param size Count of cells
+		@param sum Sum of the cage or 0
+	*/
+	void addUnit(UnitKind kind, const int* cells, int size, int sum);
+
+	/*
+		Rebuilds peers and masks of cells from units
+	*/
+	void compile();
+private:
+	// Represents rows, columns and boxes or regions followed by added units
+	ruleUnit units_[MAX_UNITS];
+	// Represents count of units
+	int unitCount_;
+	// Represents indexes of units containing every cell
+	std::uint8_t unitsOfCell_[81][MAX_UNITS_OF_CELL];
+	// Represents count of units containing every cell
+	std::uint8_t unitCountOfCell_[81];
+	// Represents cells sharing unit with every cell
+	std::uint8_t peers_[81][MAX_PEERS];
+	// Represents count of peers of every cell
+	std::uint8_t peerCount_[81];
+	// Represents region or box of every cell
+	std::uint8_t regionOfCell_[81];
+	// Represents cage unit of every cell or -1
+	std::int8_t cageOfCell_[81];
+	// Represents values allowed by cage sums in every cell
+	std::uint16_t cellMasks_[81];
+	// Represents if the boxes were replaced by regions
+	bool irregular_;
+	// Represents if the diagonals are units
+	bool diagonals_;
+};
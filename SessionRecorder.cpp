@@ -0,0 +1,138 @@
+#include "SessionRecorder.h"
+#include <cstring>
+#include <iterator>
+
+namespace
+{
+	const char MAGIC[8] = { 'S', 'U', 'D', 'O', 'K', 'R', 'E', 'C' };
+	const std::uint8_t VERSION = 1;
+	const char RECORDED_NAME[] = "Recorded";
+	const int PACKED_BOARD_SIZE = 41;
+
+	void packBoard(const int* board, char* packed)
+	{
+		memset(packed, 0, PACKED_BOARD_SIZE);
+
+		for (int cell = 0; cell < 81; cell++)
+		{
+			packed[cell / 2] |= static_cast<char>(board[cell] << (cell % 2 == 0 ? 0 : 4));
+		}
+	}
+
+	void unpackBoard(const std::uint8_t* packed, int* board)
+	{
+		for (int cell = 0; cell < 81; cell++)
+		{
+			board[cell] = cell % 2 == 0 ? packed[cell / 2] & 0x0F : packed[cell / 2] >> 4;
+		}
+	}
+}
+
+
+SessionRecorder::SessionRecorder()
+{
+}
+
+
+bool SessionRecorder::start(const std::string& filename, const int* problem, const int* solution)
+{
+	char packed[PACKED_BOARD_SIZE];
+
+	file_.open(filename, std::ios::binary | std::ios::trunc);
+	if (!file_.is_open())
+	{
+		return false;
+	}
+
+	file_.write(MAGIC, sizeof(MAGIC));
+	file_.put(static_cast<char>(VERSION));
+	packBoard(problem, packed);
+	file_.write(packed, sizeof(packed));
+	packBoard(solution, packed);
+	file_.write(packed, sizeof(packed));
+	file_.flush();
+	lastKey_ = std::chrono::steady_clock::now();
+
+	return true;
+}
+
+
+void SessionRecorder::record(char key, std::uint64_t stateHash)
+{
+	if (!file_.is_open())
+	{
+		return;
+	}
+
+	auto now = std::chrono::steady_clock::now();
+	long long microseconds = std::chrono::duration_cast<std::chrono::microseconds>(now - lastKey_).count();
+	std::uint32_t delay = static_cast<std::uint32_t>(microseconds < UINT32_MAX ? microseconds : UINT32_MAX);
+	char buffer[10];
+	int length = 0;
+
+	lastKey_ = now;
+	for (; delay >= 0x80; delay >>= 7)
+	{
+		buffer[length++] = static_cast<char>(delay | 0x80);
+	}
+
+	buffer[length++] = static_cast<char>(delay);
+	buffer[length++] = key;
+
+	for (int i = 0; i < 4; i++)
+	{
+		buffer[length++] = static_cast<char>(stateHash >> (8 * i));
+	}
+
+	file_.write(buffer, length);
+	file_.flush();
+}
+
+
+bool SessionRecorder::read(const std::string& filename, sessionRecording& recording)
+{
+	std::ifstream file(filename, std::ios::binary);
+	std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	size_t headerSize = sizeof(MAGIC) + 1 + 2 * PACKED_BOARD_SIZE;
+
+	if (data.size() < headerSize || memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0 || data[sizeof(MAGIC)] != VERSION)
+	{
+		return false;
+	}
+
+	recording.puzzle.name = RECORDED_NAME;
+	unpackBoard(data.data() + sizeof(MAGIC) + 1, recording.puzzle.problem);
+	unpackBoard(data.data() + sizeof(MAGIC) + 1 + PACKED_BOARD_SIZE, recording.puzzle.solution);
+	recording.keys.clear();
+
+	size_t position = headerSize;
+	while (position < data.size())
+	{
+		recordedKey key = recordedKey{ 0, 0, 0 };
+		int shift = 0;
+
+		while (position < data.size() && (data[position] & 0x80) && shift < 32)
+		{
+			key.delay |= static_cast<std::uint32_t>(data[position++] & 0x7F) << shift;
+			shift += 7;
+		}
+
+		// Last byte of delay, the key and the check
+		if (data.size() - position < 6)
+		{
+			break;
+		}
+
+		key.delay |= static_cast<std::uint32_t>(data[position++]) << shift;
+		key.key = static_cast<char>(data[position++]);
+
+		for (int i = 0; i < 4; i++)
+		{
+			key.check |= static_cast<std::uint32_t>(data[position++]) << (8 * i);
+		}
+
+		recording.keys.push_back(key);
+	}
+
+	return true;
+}
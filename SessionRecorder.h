@@ -0,0 +1,78 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "BuiltinPuzzles.h"
+
+
+/*
+	Represents one key of recorded session
+*/
+struct recordedKey
+{
+	// Microseconds since the previous key or the start of recording
+	std::uint32_t delay;
+	// Pressed key
+	char key;
+	// Lower half of state hash of the game after the key
+	std::uint32_t check;
+};
+
+
+/*
+	Represents recorded session with its initial puzzle
+*/
+struct sessionRecording
+{
+	// Given numbers and solution of the played puzzle
+	builtinPuzzle puzzle;
+	// Keys in order they were pressed
+	std::vector<recordedKey> keys;
+};
+
+
+/*
+	Represents writing of keys consumed by the game into file,
+	the file starts with the puzzle packed into nibbles and every
+	key takes varint delay, the key and 4 bytes of state check,
+	each key is flushed at once so the session survives exit
+*/
+class SessionRecorder
+{
+public:
+	SessionRecorder();
+
+	/*
+		Opens file and writes the initial puzzle
+
+		@param filename Name of the file
+		@param problem Given numbers in row-major order
+		@param solution Solution in row-major order
+		@return if the file was opened
+	*/
+	bool start(const std::string& filename, const int* problem, const int* solution);
+
+	/*
+		Writes key, nothing is written if the recording isn't started
+
+		@param key Pressed key
+		@param stateHash State hash of the game after the key
+	*/
+	void record(char key, std::uint64_t stateHash);
+
+	/*
+		Reads recording, a key cut off by the end of file is skipped
+
+		@param filename Name of the file
+		@param recording Read recording
+		@return if the file has valid header
+	*/
+	static bool read(const std::string& filename, sessionRecording& recording);
+private:
+	// Represents opened file
+	std::ofstream file_;
+	// Represents time of the previous key
+	std::chrono::steady_clock::time_point lastKey_;
+};
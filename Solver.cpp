@@ -0,0 +1,729 @@
+#include "Solver.h"
+#include <algorithm>
+#include "Zobrist.h"
+
+const int SearchArena::TRAIL_LENGTH = 81;
+const int SearchArena::TRAILS_IN_BLOCK = 16;
+const int Solver::DEADLINE_CHECK_INTERVAL = 1024;
+
+namespace
+{
+	// Represents index of the 3x3 square for every cell
+	const std::uint8_t SQUARE_OF_CELL[81] = {
+		0, 0, 0, 1, 1, 1, 2, 2, 2,
+		0, 0, 0, 1, 1, 1, 2, 2, 2,
+		0, 0, 0, 1, 1, 1, 2, 2, 2,
+		3, 3, 3, 4, 4, 4, 5, 5, 5,
+		3, 3, 3, 4, 4, 4, 5, 5, 5,
+		3, 3, 3, 4, 4, 4, 5, 5, 5,
+		6, 6, 6, 7, 7, 7, 8, 8, 8,
+		6, 6, 6, 7, 7, 7, 8, 8, 8,
+		6, 6, 6, 7, 7, 7, 8, 8, 8,
+	};
+
+	const std::uint16_t ALL_VALUES = 0x3FE;
+
+	// Represents xorshift generator, it's small enough to live in every search
+	std::uint64_t nextRandom(std::uint64_t& random)
+	{
+		random ^= random << 13;
+		random ^= random >> 7;
+		random ^= random << 17;
+		return random;
+	}
+
+	// Represents FNV-1a hash of values and count of empty cells, it's independent
+	// of Zobrist hash so states colliding in both are practically impossible
+	std::uint64_t getCheck(const searchState& state)
+	{
+		std::uint64_t check = 0xCBF29CE484222325ULL ^ static_cast<std::uint64_t>(state.emptyCount);
+
+		for (int cell = 0; cell < 81; cell++)
+		{
+			check = (check ^ state.values[cell]) * 0x100000001B3ULL;
+		}
+
+		return check;
+	}
+
+	// Rows are units 0..8, columns 9..17 and squares 18..26
+	int getUnitCell(int unit, int index)
+	{
+		if (unit < 9)
+		{
+			return unit * 9 + index;
+		}
+
+		if (unit < 18)
+		{
+			return index * 9 + unit - 9;
+		}
+
+		int square = unit - 18;
+		return (square / 3) * 27 + (square % 3) * 3 + (index / 3) * 9 + index % 3;
+	}
+
+	bool eliminate(const std::uint16_t* candidates, std::uint16_t* eliminated, int cell, std::uint16_t values)
+	{
+		std::uint16_t removed = candidates[cell] & values;
+
+		eliminated[cell] |= removed;
+		return removed != 0;
+	}
+
+	// Removes candidates locked in intersection of square and line from the rest of both
+	bool eliminateLockedCandidates(const std::uint16_t* candidates, std::uint16_t* eliminated)
+	{
+		// Union of candidates in every third of every row and column
+		std::uint16_t rowThirds[9][3] = { { 0 } };
+		std::uint16_t columnThirds[9][3] = { { 0 } };
+		bool changed = false;
+
+		for (int cell = 0; cell < 81; cell++)
+		{
+			rowThirds[cell / 9][cell % 9 / 3] |= candidates[cell];
+			columnThirds[cell % 9][cell / 27] |= candidates[cell];
+		}
+
+		for (int square = 0; square < 9; square++)
+		{
+			int band = square / 3;
+			int stack = square % 3;
+
+			for (int line = 0; line < 3; line++)
+			{
+				int row = band * 3 + line;
+				int column = stack * 3 + line;
+				std::uint16_t rowPart = rowThirds[row][stack];
+				std::uint16_t columnPart = columnThirds[column][band];
+				// Values of the square that can be only in this line
+				std::uint16_t rowPointing = rowPart & ~(rowThirds[band * 3 + (line + 1) % 3][stack] |
+					rowThirds[band * 3 + (line + 2) % 3][stack]);
+				std::uint16_t columnPointing = columnPart & ~(columnThirds[stack * 3 + (line + 1) % 3][band] |
+					columnThirds[stack * 3 + (line + 2) % 3][band]);
+				// Values of the line that can be only in this square
+				std::uint16_t rowClaiming = rowPart & ~(rowThirds[row][(stack + 1) % 3] | rowThirds[row][(stack + 2) % 3]);
+				std::uint16_t columnClaiming = columnPart & ~(columnThirds[column][(band + 1) % 3] |
+					columnThirds[column][(band + 2) % 3]);
+
+				for (int index = 0; index < 9; index++)
+				{
+					int squareCell = getUnitCell(18 + square, index);
+
+					if (index / 3 != stack)
+					{
+						changed |= eliminate(candidates, eliminated, row * 9 + index, rowPointing);
+					}
+
+					if (index / 3 != band)
+					{
+						changed |= eliminate(candidates, eliminated, index * 9 + column, columnPointing);
+					}
+
+					if (squareCell / 9 != row)
+					{
+						changed |= eliminate(candidates, eliminated, squareCell, rowClaiming);
+					}
+
+					if (squareCell % 9 != column)
+					{
+						changed |= eliminate(candidates, eliminated, squareCell, columnClaiming);
+					}
+				}
+			}
+		}
+
+		return changed;
+	}
+
+	// Places single found in candidates from the start of the step, it fails if other single of
+	// the step took the cell or the value of its unit
+	bool placeSingle(searchState& state, int* placed, int& count, int cell, int value)
+	{
+		if (state.values[cell] != 0)
+		{
+			return state.values[cell] == value;
+		}
+
+		if (!(state.getCandidates(cell) & (1 << value)))
+		{
+			return false;
+		}
+
+		state.place(cell, value);
+		placed[count++] = cell;
+		return true;
+	}
+}
+
+
+bool searchState::load(const int* board)
+{
+	bool valid = true;
+
+	for (int i = 0; i < 9; i++)
+	{
+		rowMask[i] = 0;
+		colMask[i] = 0;
+		squareMask[i] = 0;
+	}
+
+	emptyCount = 81;
+	hash = 0;
+	for (int cell = 0; cell < 81; cell++)
+	{
+		int value = board[cell];
+		values[cell] = 0;
+
+		if (value < 1 || value > 9)
+		{
+			continue;
+		}
+
+		if (!(getCandidates(cell) & (1 << value)))
+		{
+			valid = false;
+		}
+
+		place(cell, value);
+	}
+
+	return valid;
+}
+
+
+void searchState::store(int* board) const
+{
+	for (int cell = 0; cell < 81; cell++)
+	{
+		board[cell] = values[cell];
+	}
+}
+
+
+std::uint16_t searchState::getCandidates(int cell) const
+{
+	return ALL_VALUES & ~(rowMask[cell / 9] | colMask[cell % 9] | squareMask[SQUARE_OF_CELL[cell]]);
+}
+
+
+void searchState::place(int cell, int value)
+{
+	std::uint16_t bit = static_cast<std::uint16_t>(1 << value);
+
+	values[cell] = static_cast<std::uint8_t>(value);
+	rowMask[cell / 9] |= bit;
+	colMask[cell % 9] |= bit;
+	squareMask[SQUARE_OF_CELL[cell]] |= bit;
+	emptyCount--;
+	hash ^= Zobrist::getKey(cell, value);
+}
+
+
+void searchState::undo(int cell)
+{
+	std::uint16_t bit = static_cast<std::uint16_t>(1 << values[cell]);
+
+	hash ^= Zobrist::getKey(cell, values[cell]);
+	values[cell] = 0;
+	rowMask[cell / 9] &= ~bit;
+	colMask[cell % 9] &= ~bit;
+	squareMask[SQUARE_OF_CELL[cell]] &= ~bit;
+	emptyCount++;
+}
+
+
+SearchArena::SearchArena()
+{
+	usedCount_ = 0;
+	grow();
+}
+
+
+SearchArena::~SearchArena()
+{
+}
+
+
+SearchArena& SearchArena::local()
+{
+	thread_local SearchArena arena;
+	return arena;
+}
+
+
+searchFrame* SearchArena::acquire()
+{
+	if (freeTrails_.empty())
+	{
+		grow();
+	}
+
+	searchFrame* trail = freeTrails_.back();
+	freeTrails_.pop_back();
+	usedCount_++;
+
+	return trail;
+}
+
+
+void SearchArena::release(searchFrame* trail)
+{
+	freeTrails_.push_back(trail);
+	usedCount_--;
+}
+
+
+void SearchArena::reset()
+{
+	freeTrails_.clear();
+
+	for (auto& block : blocks_)
+	{
+		for (int i = TRAILS_IN_BLOCK - 1; i >= 0; i--)
+		{
+			freeTrails_.push_back(&block[i * TRAIL_LENGTH]);
+		}
+	}
+
+	usedCount_ = 0;
+}
+
+
+int SearchArena::getUsedCount() const
+{
+	return usedCount_;
+}
+
+
+void SearchArena::grow()
+{
+	blocks_.emplace_back(new searchFrame[TRAIL_LENGTH * TRAILS_IN_BLOCK]);
+	freeTrails_.reserve(blocks_.size() * TRAILS_IN_BLOCK);
+
+	for (int i = TRAILS_IN_BLOCK - 1; i >= 0; i--)
+	{
+		freeTrails_.push_back(&blocks_.back()[i * TRAIL_LENGTH]);
+	}
+}
+
+
+bool Solver::isBudgetExhausted(const solveBudget& budget, const solveStats& stats)
+{
+	if (budget.maxNodes > 0 && stats.nodes >= budget.maxNodes)
+	{
+		return true;
+	}
+
+	if (budget.cancel != nullptr && budget.cancel->load(std::memory_order_relaxed))
+	{
+		return true;
+	}
+
+	return stats.nodes % DEADLINE_CHECK_INTERVAL == 0 &&
+		std::chrono::steady_clock::now() >= budget.deadline;
+}
+
+
+Deduction Solver::deduce(searchState& state, std::uint16_t* eliminated, int* placed, int& count)
+{
+	std::uint16_t candidates[81];
+	// Hidden singles as cell and value, every unit gives at most 9
+	int hiddenCells[27 * 9];
+	int hiddenValues[27 * 9];
+	int hiddenCount = 0;
+
+	count = 0;
+
+	for (int cell = 0; cell < 81; cell++)
+	{
+		candidates[cell] = state.values[cell] == 0 ? state.getCandidates(cell) & ~eliminated[cell] : 0;
+
+		if (state.values[cell] == 0 && candidates[cell] == 0)
+		{
+			return Deduction::CONTRADICTION;
+		}
+	}
+
+	for (int cell = 0; cell < 81; cell++)
+	{
+		std::uint16_t mask = candidates[cell];
+
+		if (mask != 0 && (mask & (mask - 1)) == 0 &&
+			!placeSingle(state, placed, count, cell, countBits(static_cast<std::uint16_t>(mask - 1))))
+		{
+			return Deduction::CONTRADICTION;
+		}
+	}
+
+	if (count > 0)
+	{
+		return Deduction::NAKED_SINGLES;
+	}
+
+	for (int unit = 0; unit < 27; unit++)
+	{
+		std::uint16_t used = 0;
+		std::uint16_t once = 0;
+		std::uint16_t twice = 0;
+
+		for (int index = 0; index < 9; index++)
+		{
+			int cell = getUnitCell(unit, index);
+
+			used |= 1 << state.values[cell];
+			twice |= once & candidates[cell];
+			once |= candidates[cell];
+		}
+
+		if (((used | once) & ALL_VALUES) != ALL_VALUES)
+		{
+			return Deduction::CONTRADICTION;
+		}
+
+		for (int index = 0; index < 9; index++)
+		{
+			int cell = getUnitCell(unit, index);
+
+			for (std::uint16_t hidden = candidates[cell] & once & ~twice; hidden != 0; hidden &= hidden - 1)
+			{
+				hiddenCells[hiddenCount] = cell;
+				hiddenValues[hiddenCount++] = countBits(static_cast<std::uint16_t>((hidden & ~(hidden - 1)) - 1));
+			}
+		}
+	}
+
+	for (int i = 0; i < hiddenCount; i++)
+	{
+		if (!placeSingle(state, placed, count, hiddenCells[i], hiddenValues[i]))
+		{
+			return Deduction::CONTRADICTION;
+		}
+	}
+
+	if (count > 0)
+	{
+		return Deduction::HIDDEN_SINGLES;
+	}
+
+	return eliminateLockedCandidates(candidates, eliminated) ? Deduction::LOCKED_CANDIDATES : Deduction::NONE;
+}
+
+
+Solver::Solver()
+{
+}
+
+
+Solver::Solver(const searchOptions& options)
+{
+	options_ = options;
+}
+
+
+int Solver::getNextEmptyCell(const searchState& state, int from, std::uint64_t& random) const
+{
+	if (options_.cellOrder == CellOrder::ROW_MAJOR)
+	{
+		for (int cell = from; cell < 81; cell++)
+		{
+			if (state.values[cell] == 0)
+				return cell;
+		}
+
+		return -1;
+	}
+
+	bool randomTies = options_.cellOrder == CellOrder::RANDOM_MIN_CANDIDATES;
+	int best = -1;
+	int bestCount = 10;
+	int ties = 0;
+
+	for (int cell = 0; cell < 81; cell++)
+	{
+		if (state.values[cell] != 0)
+		{
+			continue;
+		}
+
+		int count = countBits(state.getCandidates(cell));
+		if (count < bestCount)
+		{
+			best = cell;
+			bestCount = count;
+			ties = 1;
+
+			if (count == 0 || (count == 1 && !randomTies))
+			{
+				return best;
+			}
+		}
+		else if (randomTies && count == bestCount && nextRandom(random) % ++ties == 0)
+		{
+			best = cell;
+		}
+	}
+
+	return best;
+}
+
+
+int Solver::takeNextValue(searchFrame& frame, std::uint64_t& random) const
+{
+	int value = 1;
+
+	switch (options_.valueOrder)
+	{
+	case ValueOrder::ASCENDING:
+		while (!(frame.remaining & (1 << value)))
+		{
+			value++;
+		}
+		break;
+	case ValueOrder::DESCENDING:
+		value = 9;
+		while (!(frame.remaining & (1 << value)))
+		{
+			value--;
+		}
+		break;
+	case ValueOrder::RANDOM:
+		for (int skip = static_cast<int>(nextRandom(random) % countBits(frame.remaining)); ; value++)
+		{
+			if ((frame.remaining & (1 << value)) && skip-- == 0)
+			{
+				break;
+			}
+		}
+		break;
+	}
+
+	frame.remaining &= ~(1 << value);
+	return value;
+}
+
+
+searchFrame Solver::createFrame(const searchState& state, int cell, solveStats& stats) const
+{
+	searchFrame frame = searchFrame{ cell, 0, state.getCandidates(cell) };
+
+	if (options_.transpositions != nullptr && frame.remaining != 0 && options_.transpositions->contains(state.hash, getCheck(state)))
+	{
+		frame.remaining = 0;
+		stats.transpositionHits++;
+	}
+
+	return frame;
+}
+
+
+bool Solver::propagate(searchState& state, searchFrame* trail, int& depth, solveStats& stats) const
+{
+	std::uint16_t eliminated[81] = { 0 };
+	int placed[81];
+	int count;
+	Deduction deduction;
+
+	do {
+		deduction = deduce(state, eliminated, placed, count);
+
+		// Values placed before contradiction was found are withdrawn with the trail
+		for (int i = 0; i < count; i++)
+		{
+			trail[++depth] = searchFrame{ placed[i], state.values[placed[i]], 0 };
+		}
+
+		stats.propagations += count;
+	} while (deduction != Deduction::NONE && deduction != Deduction::CONTRADICTION);
+
+	return deduction != Deduction::CONTRADICTION;
+}
+
+
+void Solver::unwind(searchState& state, searchFrame* trail, int depth) const
+{
+	for (; depth >= 0; depth--)
+	{
+		if (trail[depth].value != 0)
+		{
+			state.undo(trail[depth].cell);
+			trail[depth].value = 0;
+		}
+	}
+}
+
+
+SolveResult Solver::solve(searchState& state, const solveBudget& budget, solveStats& stats) const
+{
+	return search(state, nullptr, budget, stats);
+}
+
+
+SolveResult Solver::enumerate(searchState& state, SolutionVisitor& visitor, const solveBudget& budget, solveStats& stats) const
+{
+	return search(state, &visitor, budget, stats);
+}
+
+
+SolveResult Solver::countSolutions(searchState& state, long long limit, long long& count,
+	const solveBudget& budget, solveStats& stats) const
+{
+	class countingVisitor : public SolutionVisitor
+	{
+	public:
+		countingVisitor(long long limit) : limit_(limit), count_(0) {}
+
+		bool onSolution(const searchState&) override
+		{
+			return ++count_ < limit_;
+		}
+
+		long long getCount() const
+		{
+			return count_;
+		}
+	private:
+		long long limit_;
+		long long count_;
+	};
+
+	countingVisitor visitor(limit);
+	SolveResult result = search(state, &visitor, budget, stats);
+
+	count = visitor.getCount();
+	return result;
+}
+
+
+SolveResult Solver::search(searchState& state, SolutionVisitor* visitor, const solveBudget& budget, solveStats& stats) const
+{
+	auto start = std::chrono::steady_clock::now();
+	SolveResult result = SolveResult::UNSOLVABLE;
+	std::uint64_t random = options_.seed != 0 ? options_.seed : 1;
+	long long restartLimit = visitor == nullptr ? options_.restartNodes : 0;
+	long long nodesSinceRestart = 0;
+	SearchArena& arena = SearchArena::local();
+	searchFrame* trail = arena.acquire();
+	int depth = -1;
+	// Frames below this depth have solution in their subtree
+	int liveDepth = 0;
+	// Contradiction leaves forced frames on the trail and the loop withdraws them
+	bool consistent = !options_.propagation || propagate(state, trail, depth, stats);
+	int firstCell = consistent ? getNextEmptyCell(state, 0, random) : -1;
+	bool solvedByPropagation = consistent && firstCell < 0;
+
+	if (solvedByPropagation)
+	{
+		result = SolveResult::SOLVED;
+
+		if (visitor != nullptr)
+		{
+			visitor->onSolution(state);
+		}
+	}
+	else if (consistent)
+	{
+		trail[++depth] = createFrame(state, firstCell, stats);
+	}
+
+	while (!solvedByPropagation && depth >= 0)
+	{
+		searchFrame& frame = trail[depth];
+
+		if (frame.value != 0)
+		{
+			state.undo(frame.cell);
+			frame.value = 0;
+			stats.backtracks++;
+		}
+
+		if (frame.remaining == 0)
+		{
+			// Every candidate failed, so the state before the cell has no solution
+			if (options_.transpositions != nullptr && depth >= liveDepth && state.getCandidates(frame.cell) != 0)
+			{
+				if (options_.transpositions->store(state.hash, getCheck(state)))
+				{
+					stats.transpositionReplacements++;
+				}
+			}
+
+			depth--;
+			continue;
+		}
+
+		if (isBudgetExhausted(budget, stats))
+		{
+			result = SolveResult::BUDGET_EXHAUSTED;
+			break;
+		}
+
+		if (restartLimit > 0 && nodesSinceRestart >= restartLimit)
+		{
+			unwind(state, trail, depth);
+			restartLimit *= 2;
+			nodesSinceRestart = 0;
+			depth = -1;
+
+			// Contradiction leaves forced frames on the trail and the loop withdraws them
+			if (options_.propagation && !propagate(state, trail, depth, stats))
+			{
+				continue;
+			}
+
+			firstCell = getNextEmptyCell(state, 0, random);
+			trail[++depth] = createFrame(state, firstCell, stats);
+			continue;
+		}
+
+		int cell = frame.cell;
+		int value = takeNextValue(frame, random);
+		state.place(cell, value);
+		frame.value = value;
+		stats.nodes++;
+		nodesSinceRestart++;
+
+		if (options_.propagation)
+		{
+			int frameDepth = depth;
+			bool propagated = propagate(state, trail, depth, stats);
+
+			liveDepth = std::min(liveDepth, frameDepth + 1);
+			if (!propagated)
+			{
+				// Forced frames are withdrawn first and then the next candidate is tried
+				continue;
+			}
+		}
+
+		int nextCell = getNextEmptyCell(state, cell + 1, random);
+		if (nextCell < 0)
+		{
+			result = SolveResult::SOLVED;
+			liveDepth = depth + 1;
+
+			// The enumeration continues with the next candidate of the last cell
+			if (visitor != nullptr && visitor->onSolution(state))
+			{
+				continue;
+			}
+
+			break;
+		}
+
+		depth++;
+		liveDepth = std::min(liveDepth, depth);
+		trail[depth] = createFrame(state, nextCell, stats);
+	}
+
+	if (result == SolveResult::BUDGET_EXHAUSTED || visitor != nullptr)
+	{
+		unwind(state, trail, depth);
+	}
+
+	arena.release(trail);
+	stats.elapsedMicroseconds += std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now() - start).count();
+
+	return result;
+}
@@ -0,0 +1,427 @@
+#pragma once
+#include <chrono>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include "TranspositionTable.h"
+
+
+/*
+	Represents result of the budgeted solving
+*/
+enum class SolveResult
+{
+	SOLVED, UNSOLVABLE, BUDGET_EXHAUSTED
+};
+
+
+/*
+	Represents limits of one solving call, every limit
+	is disabled by default
+*/
+struct solveBudget
+{
+	// Maximal count of visited nodes, 0 means unlimited
+	long long maxNodes = 0;
+	// Time when the solving is stopped
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+	// Token that stops the solving when it is set from other thread
+	const std::atomic<bool>* cancel = nullptr;
+};
+
+
+/*
+	Represents statistics gathered during solving
+*/
+struct solveStats
+{
+	// Count of visited nodes
+	long long nodes = 0;
+	// Count of withdrawn placements
+	long long backtracks = 0;
+	// Duration of solving in microseconds
+	long long elapsedMicroseconds = 0;
+	// Count of states skipped because the transposition table knew them
+	long long transpositionHits = 0;
+	// Count of states that pushed other state out of the transposition table
+	long long transpositionReplacements = 0;
+	// Count of values placed by propagation without branching
+	long long propagations = 0;
+};
+
+
+/*
+	Represents order in which empty cells are chosen
+*/
+enum class CellOrder
+{
+	ROW_MAJOR, MIN_CANDIDATES, RANDOM_MIN_CANDIDATES
+};
+
+
+/*
+	Represents order in which candidates of the cell are tried
+*/
+enum class ValueOrder
+{
+	ASCENDING, DESCENDING, RANDOM
+};
+
+
+/*
+	Represents configuration of the search
+*/
+struct searchOptions
+{
+	// Order of cells
+	CellOrder cellOrder = CellOrder::ROW_MAJOR;
+	// Order of values
+	ValueOrder valueOrder = ValueOrder::ASCENDING;
+	// Seed of random choices
+	std::uint64_t seed = 1;
+	// Nodes before the first restart, 0 disables restarts, the limit
+	// doubles after every restart so the search stays complete
+	long long restartNodes = 0;
+	// Table of states without solution shared between searches, nullptr
+	// disables it, it pays off with restarts and repeated searches of
+	// similar states
+	TranspositionTable* transpositions = nullptr;
+	// Places naked singles, hidden singles and values left after
+	// elimination of locked candidates before the search and after
+	// every placement, StepSolver steps without it
+	bool propagation = false;
+};
+
+
+/*
+	Represents one decision on the trail of the iterative search
+*/
+struct searchFrame
+{
+	// Index of the cell in board
+	int cell;
+	// Value placed into the cell, 0 if nothing is placed yet
+	int value;
+	// Bitmask of candidates that weren't tried yet
+	std::uint16_t remaining;
+};
+
+
+/*
+	Represents state of the board during search, it doesn't own
+	any memory so it can be freely copied and many states can
+	be solved on one thread
+*/
+struct searchState
+{
+	// Values of cells in row-major order, 0 means empty cell
+	std::uint8_t values[81];
+	// Bitmasks of used values in rows, bit 1 represents value 1
+	std::uint16_t rowMask[9];
+	// Bitmasks of used values in columns
+	std::uint16_t colMask[9];
+	// Bitmasks of used values in 3x3 squares
+	std::uint16_t squareMask[9];
+	// Count of empty cells
+	int emptyCount;
+	// Zobrist hash of values, it's updated by place and undo
+	std::uint64_t hash;
+
+	/*
+		Loads board in row-major order
+
+		@param board Board with values 0..9
+		@return if the given numbers don't break sudoku rules
+	*/
+	bool load(const int* board);
+
+	/*
+		Stores board in row-major order
+
+		@param board Board where the values are written
+	*/
+	void store(int* board) const;
+
+	/*
+		Get bitmask of values that can be placed into cell
+
+		@param cell Index of the cell
+		@return Bitmask of candidates
+	*/
+	std::uint16_t getCandidates(int cell) const;
+
+	/*
+		Places value into empty cell without checking rules
+
+		@param cell Index of the cell
+		@param value Placed value
+	*/
+	void place(int cell, int value);
+
+	/*
+		Removes value from cell
+
+		@param cell Index of the cell
+	*/
+	void undo(int cell);
+};
+
+
+/*
+	Counts values in bitmask of candidates
+
+	@param mask Bitmask of values
+	@return count of set bits
+*/
+constexpr int countBits(std::uint16_t mask)
+{
+	int count = 0;
+
+	for (; mask != 0; mask &= mask - 1)
+	{
+		count++;
+	}
+
+	return count;
+}
+
+
+/*
+	Represents logical deduction applied by one propagation step,
+	ordered from the easiest
+*/
+enum class Deduction
+{
+	NONE, NAKED_SINGLES, HIDDEN_SINGLES, LOCKED_CANDIDATES, CONTRADICTION
+};
+
+
+/*
+	Represents preallocated memory for trails of searches running
+	on one thread, the memory is never freed between puzzles
+*/
+class SearchArena
+{
+public:
+	SearchArena();
+	~SearchArena();
+
+	/*
+		Get arena of the calling thread
+
+		@return Arena of the thread
+	*/
+	static SearchArena& local();
+
+	/*
+		Acquires trail for one search, new block is allocated
+		only if every preallocated trail is in use
+
+		@return Trail with TRAIL_LENGTH frames
+	*/
+	searchFrame* acquire();
+
+	/*
+		Returns trail back to arena
+
+		@param trail Trail acquired from this arena
+	*/
+	void release(searchFrame* trail);
+
+	/*
+		Marks every trail as free without freeing memory
+	*/
+	void reset();
+
+	/*
+		Get count of trails currently in use
+
+		@return count of used trails
+	*/
+	int getUsedCount() const;
+public:
+	const static int TRAIL_LENGTH;
+	const static int TRAILS_IN_BLOCK;
+private:
+	/*
+		Allocates next block of trails and puts them to free list
+	*/
+	void grow();
+private:
+	// Represents allocated blocks of trails
+	std::vector<std::unique_ptr<searchFrame[]>> blocks_;
+	// Represents trails ready to be acquired
+	std::vector<searchFrame*> freeTrails_;
+	// Represents count of trails in use
+	int usedCount_;
+};
+
+
+/*
+	Represents receiver of solutions found by enumeration
+*/
+class SolutionVisitor
+{
+public:
+	virtual ~SolutionVisitor() {}
+
+	/*
+		Receives solved state
+
+		@param state Solved state
+		@return if the enumeration continues
+	*/
+	virtual bool onSolution(const searchState& state) = 0;
+};
+
+
+/*
+	Represents iterative backtracking search with explicit
+	stack of decisions
+*/
+class Solver
+{
+public:
+	Solver();
+
+	/*
+		Creates solver with specific search configuration
+
+		@param options Configuration of the search
+	*/
+	Solver(const searchOptions& options);
+
+	/*
+		Finds solution of the state within given limits, if the
+		solution isn't found the state is restored
+
+		@param state State with loaded problem
+		@param budget Limits of the solving
+		@param stats Statistics gathered so far
+		@return Result of the solving
+	*/
+	SolveResult solve(searchState& state, const solveBudget& budget, solveStats& stats) const;
+
+	/*
+		Passes every solution to the visitor until it stops the
+		enumeration, restarts are disabled and the state is restored
+
+		@param state State with loaded problem
+		@param visitor Receiver of solutions
+		@param budget Limits of the solving
+		@param stats Statistics gathered so far
+		@return SOLVED if any solution was found, UNSOLVABLE if there is
+			none and BUDGET_EXHAUSTED if the enumeration didn't finish
+	*/
+	SolveResult enumerate(searchState& state, SolutionVisitor& visitor, const solveBudget& budget, solveStats& stats) const;
+
+	/*
+		Counts solutions up to the limit, the state is restored
+
+		@param state State with loaded problem
+		@param limit Count where the counting stops
+		@param count Count of found solutions
+		@param budget Limits of the solving
+		@param stats Statistics gathered so far
+		@return Result of the enumeration
+	*/
+	SolveResult countSolutions(searchState& state, long long limit, long long& count,
+		const solveBudget& budget, solveStats& stats) const;
+
+	/*
+		Checks if any limit of budget is exceeded
+
+		@param budget Limits of the solving
+		@param stats Statistics of the solving
+		@return If the solving has to stop
+	*/
+	static bool isBudgetExhausted(const solveBudget& budget, const solveStats& stats);
+
+	/*
+		Applies the easiest deduction that makes progress, every cell
+		is judged by the same candidates and the found values are
+		placed together, so the result doesn't depend on order of
+		cells and symmetric boards get symmetric steps
+
+		@param state State where the values are placed
+		@param eliminated Candidates of cells removed by locked candidates,
+			they are added here because state knows only placed values
+		@param placed Cells placed by the step, also if contradiction was found
+		@param count Count of placed cells
+		@return Applied deduction, NONE if nothing changed
+	*/
+	static Deduction deduce(searchState& state, std::uint16_t* eliminated, int* placed, int& count);
+public:
+	const static int DEADLINE_CHECK_INTERVAL;
+private:
+	// Steps through the same order of cells and values
+	friend class StepSolver;
+
+	/*
+		Finds next empty cell in the order of options
+
+		@param state Searched state
+		@param from Index where the row-major finding starts
+		@param random State of random generator
+		@return Index of the cell or -1 if the board is full
+	*/
+	int getNextEmptyCell(const searchState& state, int from, std::uint64_t& random) const;
+
+	/*
+		Takes next candidate from remaining candidates of frame
+
+		@param frame Frame of the cell
+		@param random State of random generator
+		@return Taken value
+	*/
+	int takeNextValue(searchFrame& frame, std::uint64_t& random) const;
+
+	/*
+		Searches the state, the search stops at the first solution
+		if there is no visitor
+
+		@param state State with loaded problem
+		@param visitor Receiver of solutions or nullptr
+		@param budget Limits of the solving
+		@param stats Statistics gathered so far
+		@return Result of the search
+	*/
+	SolveResult search(searchState& state, SolutionVisitor* visitor, const solveBudget& budget, solveStats& stats) const;
+
+	/*
+		Creates frame of the cell, the frame has no candidates if the
+		transposition table knows the state has no solution
+
+		@param state Searched state
+		@param cell Index of the cell
+		@param stats Statistics gathered so far
+		@return Frame of the cell
+	*/
+	searchFrame createFrame(const searchState& state, int cell, solveStats& stats) const;
+
+	/*
+		Places values forced by deduce until nothing changes, every
+		forced value gets frame without other candidates, so
+		backtracking withdraws it like any placement
+
+		@param state Searched state
+		@param trail Trail of the search
+		@param depth Depth of the last frame, it's moved to the last forced frame
+		@param stats Statistics gathered so far
+		@return if no cell or unit was left without candidates
+	*/
+	bool propagate(searchState& state, searchFrame* trail, int& depth, solveStats& stats) const;
+
+	/*
+		Undoes every placement on the trail
+
+		@param state Searched state
+		@param trail Trail of the search
+		@param depth Depth of the last frame
+	*/
+	void unwind(searchState& state, searchFrame* trail, int depth) const;
+private:
+	// Represents configuration of the search
+	searchOptions options_;
+};
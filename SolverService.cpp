@@ -0,0 +1,197 @@
+#include "SolverService.h"
+#include "VariantSolver.h"
+
+
+SolverService::SolverService(const serviceSettings& settings)
+{
+	settings_ = settings;
+	settings_.workers = settings_.workers < 1 ? 1 : settings_.workers;
+	settings_.queueDepth = settings_.queueDepth < 1 ? 1 : settings_.queueDepth;
+	settings_.batchSize = settings_.batchSize < 1 ? 1 : settings_.batchSize;
+
+	stopping_ = false;
+	batches_ = 0;
+	requests_ = 0;
+
+	for (int i = 0; i < settings_.workers; i++)
+	{
+		workers_.emplace_back(&SolverService::work, this);
+	}
+}
+
+
+SolverService::~SolverService()
+{
+	stop();
+}
+
+
+std::future<serviceReply> SolverService::submit(const int* board, const PuzzleRules* rules)
+{
+	serviceRequest request;
+	std::future<serviceReply> reply = request.reply.get_future();
+
+	request.deadline = std::chrono::steady_clock::now() + settings_.timeout;
+	for (int cell = 0; cell < 81; cell++)
+	{
+		request.board[cell] = board[cell];
+	}
+
+	if (rules != nullptr && !rules->isClassic())
+	{
+		request.rules = std::make_shared<const PuzzleRules>(*rules);
+	}
+
+	std::unique_lock<std::mutex> lock(mutex_);
+	notFull_.wait(lock, [this] {
+		return stopping_ || queue_.size() < static_cast<size_t>(settings_.queueDepth);
+	});
+
+	if (stopping_)
+	{
+		lock.unlock();
+		serviceReply cancelled = serviceReply();
+		cancelled.result = SolveResult::BUDGET_EXHAUSTED;
+		request.reply.set_value(cancelled);
+		return reply;
+	}
+
+	queue_.push_back(std::move(request));
+	lock.unlock();
+	notEmpty_.notify_one();
+
+	return reply;
+}
+
+
+void SolverService::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (stopping_ && workers_.empty())
+		{
+			return;
+		}
+
+		stopping_ = true;
+	}
+
+	notEmpty_.notify_all();
+	notFull_.notify_all();
+
+	for (auto& worker : workers_)
+	{
+		worker.join();
+	}
+
+	workers_.clear();
+}
+
+
+int SolverService::getQueueDepth() const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return static_cast<int>(queue_.size());
+}
+
+
+long long SolverService::getBatchCount() const
+{
+	return batches_;
+}
+
+
+long long SolverService::getRequestCount() const
+{
+	return requests_;
+}
+
+
+void SolverService::work()
+{
+	std::vector<serviceRequest> batch;
+	batch.reserve(settings_.batchSize);
+
+	while (true)
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		notEmpty_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+
+		if (queue_.empty())
+		{
+			return;
+		}
+
+		if (settings_.batchDelay.count() > 0 &&
+			queue_.size() < static_cast<size_t>(settings_.batchSize))
+		{
+			notEmpty_.wait_for(lock, settings_.batchDelay, [this] {
+				return stopping_ || queue_.size() >= static_cast<size_t>(settings_.batchSize);
+			});
+		}
+
+		while (!queue_.empty() && batch.size() < static_cast<size_t>(settings_.batchSize))
+		{
+			batch.push_back(std::move(queue_.front()));
+			queue_.pop_front();
+		}
+
+		lock.unlock();
+		notFull_.notify_all();
+
+		if (batch.empty())
+		{
+			continue;
+		}
+
+		batches_++;
+		for (auto& request : batch)
+		{
+			process(request);
+		}
+
+		batch.clear();
+	}
+}
+
+
+void SolverService::process(serviceRequest& request)
+{
+	serviceReply reply = serviceReply();
+	solveBudget budget;
+	searchState state;
+	searchOptions options;
+
+	options.cellOrder = CellOrder::MIN_CANDIDATES;
+	options.propagation = true;
+	budget.maxNodes = settings_.maxNodes;
+	budget.deadline = request.deadline;
+	budget.cancel = &stopping_;
+
+	if (request.rules)
+	{
+		variantState variant;
+
+		if (!variant.load(*request.rules, request.board))
+		{
+			reply.result = SolveResult::UNSOLVABLE;
+		}
+		else
+		{
+			reply.result = VariantSolver().solve(variant, budget, reply.stats);
+			variant.store(reply.board);
+		}
+	}
+	else if (!state.load(request.board))
+	{
+		reply.result = SolveResult::UNSOLVABLE;
+	}
+	else
+	{
+		reply.result = Solver(options).solve(state, budget, reply.stats);
+		state.store(reply.board);
+	}
+
+	requests_++;
+	request.reply.set_value(reply);
+}
@@ -0,0 +1,142 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "PuzzleRules.h"
+#include "Solver.h"
+
+
+/*
+	Represents settings of the solving service
+*/
+struct serviceSettings
+{
+	// Count of worker threads
+	int workers = 4;
+	// Maximal count of waiting requests, submitting blocks when it's reached
+	int queueDepth = 1024;
+	// Maximal count of requests taken by worker at once
+	int batchSize = 16;
+	// Time that worker waits for filling of the batch
+	std::chrono::microseconds batchDelay = std::chrono::microseconds(0);
+	// Node budget of one request, 0 means unlimited
+	long long maxNodes = 10000000;
+	// Time budget of one request
+	std::chrono::milliseconds timeout = std::chrono::milliseconds(1000);
+};
+
+
+/*
+	Represents answer to one request
+*/
+struct serviceReply
+{
+	// Result of the solving
+	SolveResult result;
+	// Solved board in row-major order if the result is SOLVED
+	int board[81];
+	// Statistics of the solving
+	solveStats stats;
+};
+
+
+/*
+	Represents one waiting request
+*/
+struct serviceRequest
+{
+	// Problem in row-major order
+	int board[81];
+	// Variant rules of the problem, null means classic rules
+	std::shared_ptr<const PuzzleRules> rules;
+	// Time when the request runs out of time, waiting in queue counts too
+	std::chrono::steady_clock::time_point deadline;
+	// Represents where the answer is delivered
+	std::promise<serviceReply> reply;
+};
+
+
+/*
+	Represents pool of workers that solve queued problems
+	in batches
+*/
+class SolverService
+{
+public:
+	SolverService(const serviceSettings& settings);
+	~SolverService();
+
+	/*
+		Queues problem for solving, the call blocks while the
+		queue is full so the caller is slowed down, the timeout
+		of the request starts here, problems with variant rules
+		are solved by VariantSolver
+
+		@param board Problem in row-major order
+		@param rules Rules of the problem, null means classic rules
+		@return Future answer
+	*/
+	std::future<serviceReply> submit(const int* board, const PuzzleRules* rules = nullptr);
+
+	/*
+		Stops workers, problems being solved are cancelled
+	*/
+	void stop();
+
+	/*
+		Get count of waiting requests
+
+		@return count of waiting requests
+	*/
+	int getQueueDepth() const;
+
+	/*
+		Get count of batches taken by workers
+
+		@return count of batches
+	*/
+	long long getBatchCount() const;
+
+	/*
+		Get count of solved requests
+
+		@return count of solved requests
+	*/
+	long long getRequestCount() const;
+private:
+	/*
+		Represents loop of one worker
+	*/
+	void work();
+
+	/*
+		Solves one request and delivers the answer
+
+		@param request Solved request
+	*/
+	void process(serviceRequest& request);
+private:
+	// Represents settings of the service
+	serviceSettings settings_;
+	// Represents waiting requests
+	std::deque<serviceRequest> queue_;
+	// Represents lock of the queue
+	mutable std::mutex mutex_;
+	// Represents signal for workers
+	std::condition_variable notEmpty_;
+	// Represents signal for blocked submitters
+	std::condition_variable notFull_;
+	// Represents worker threads
+	std::vector<std::thread> workers_;
+	// Represents if the service is stopping, it also cancels solving
+	std::atomic<bool> stopping_;
+	// Represents count of taken batches
+	std::atomic<long long> batches_;
+	// Represents count of solved requests
+	std::atomic<long long> requests_;
+};
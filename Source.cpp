@@ -1,10 +1,40 @@
 #include <iostream>
+#include <cstring>
 #include "ConsoleWindow.h"
 
-int main()
+int main(int argc, char* argv[])
 {
-	ConsoleWindow().run();
-	
-	getchar();
+	// ConsoleSudoku --replay <file> [--realtime] plays recorded session
+	if (argc >= 3 && strcmp(argv[1], "--replay") == 0)
+	{
+		sessionRecording recording;
+
+		if (!SessionRecorder::read(argv[2], recording))
+		{
+			std::cerr << "Couldn't read recording " << argv[2] << std::endl;
+			return 1;
+		}
+
+		try {
+			ConsoleWindow().replay(recording, argc >= 4 && strcmp(argv[3], "--realtime") == 0);
+		}
+		catch (const std::exception&)
+		{
+			return 1;
+		}
+
+		getchar();
+		return 0;
+	}
+
+	// The window shows the error itself, the exception only stops the game
+	try {
+		ConsoleWindow().run();
+	}
+	catch (const std::exception&)
+	{
+		return 1;
+	}
+
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "StepSolver.h"
+
+
+StepSolver::StepSolver(const searchState& state, const searchOptions& options)
+	: solver_(options), trail_(SearchArena::TRAIL_LENGTH)
+{
+	state_ = state;
+	random_ = options.seed != 0 ? options.seed : 1;
+	finished_ = false;
+	depth_ = 0;
+
+	int firstCell = solver_.getNextEmptyCell(state_, 0, random_);
+	solved_ = firstCell < 0;
+
+	if (!solved_)
+	{
+		trail_[0] = solver_.createFrame(state_, firstCell, stats_);
+	}
+}
+
+
+bool StepSolver::next(solveStep& step)
+{
+	if (finished_)
+	{
+		return false;
+	}
+
+	if (solved_)
+	{
+		finished_ = true;
+		step = solveStep{ StepKind::SOLVED, -1, 0, depth_ };
+		return true;
+	}
+
+	while (depth_ >= 0)
+	{
+		searchFrame& frame = trail_[depth_];
+
+		if (frame.value != 0)
+		{
+			step = solveStep{ StepKind::BACKTRACK, frame.cell, frame.value, depth_ };
+			state_.undo(frame.cell);
+			frame.value = 0;
+			stats_.backtracks++;
+			return true;
+		}
+
+		if (frame.remaining == 0)
+		{
+			depth_--;
+			continue;
+		}
+
+		int value = solver_.takeNextValue(frame, random_);
+		state_.place(frame.cell, value);
+		frame.value = value;
+		stats_.nodes++;
+		step = solveStep{ StepKind::PLACE, frame.cell, value, depth_ };
+
+		int nextCell = solver_.getNextEmptyCell(state_, frame.cell + 1, random_);
+		if (nextCell < 0)
+		{
+			solved_ = true;
+		}
+		else
+		{
+			depth_++;
+			trail_[depth_] = solver_.createFrame(state_, nextCell, stats_);
+		}
+
+		return true;
+	}
+
+	finished_ = true;
+	step = solveStep{ StepKind::UNSOLVABLE, -1, 0, -1 };
+	return true;
+}
+
+
+bool StepSolver::isFinished() const
+{
+	return finished_;
+}
+
+
+const searchState& StepSolver::getState() const
+{
+	return state_;
+}
+
+
+const solveStats& StepSolver::getStats() const
+{
+	return stats_;
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <vector>
+#include "Solver.h"
+
+
+/*
+	Represents kind of one step of the search
+*/
+enum class StepKind
+{
+	PLACE, BACKTRACK, SOLVED, UNSOLVABLE
+};
+
+
+/*
+	Represents one step of the search
+*/
+struct solveStep
+{
+	// Kind of the step
+	StepKind kind;
+	// Index of the changed cell, -1 for the final steps
+	int cell;
+	// Placed or removed value
+	int value;
+	// Depth of the decision on the trail
+	int depth;
+};
+
+
+/*
+	Represents search that is resumed by the caller, every call
+	advances it by one placement or backtrack so it can be paused
+	or dropped between any two steps, the order of cells and values
+	is the same as in Solver but restarts are not used
+*/
+class StepSolver
+{
+public:
+	/*
+		Creates search of the state, the state is copied
+
+		@param state State with loaded problem
+		@param options Configuration of the search
+	*/
+	StepSolver(const searchState& state, const searchOptions& options);
+
+	/*
+		Advances the search by one step
+
+		@param step Step that was made
+		@return if there was any step, the last step is SOLVED or UNSOLVABLE
+	*/
+	bool next(solveStep& step);
+
+	/*
+		Checks if the search has finished
+
+		@return if SOLVED or UNSOLVABLE step was already made
+	*/
+	bool isFinished() const;
+
+	/*
+		Get searched state after the last step
+
+		@return searched state
+	*/
+	const searchState& getState() const;
+
+	/*
+		Get statistics of steps made so far
+
+		@return statistics of the search
+	*/
+	const solveStats& getStats() const;
+private:
+	// Represents solver providing order of cells and values
+	Solver solver_;
+	// Represents searched state
+	searchState state_;
+	// Represents trail of decisions, it's owned because the search may outlive arena of the thread
+	std::vector<searchFrame> trail_;
+	// Represents depth of the last frame
+	int depth_;
+	// Represents state of random generator
+	std::uint64_t random_;
+	// Represents if the board is full and SOLVED step is pending
+	bool solved_;
+	// Represents if the final step was made
+	bool finished_;
+	// Represents statistics of the search
+	solveStats stats_;
+};
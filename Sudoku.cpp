@@ -2,38 +2,67 @@
 
 const int Sudoku::SIZE_BOARD = 9;
 const int Sudoku::SIZE_SQUARE = 3;
+const long long Sudoku::MAX_SOLVE_NODES = 10000000;
 
-Sudoku::Sudoku()
+Sudoku::Sudoku(const std::string& filename)
 {
-	solutionBoard_ = new int[SIZE_BOARD*SIZE_BOARD];
-	playBoard_ = new sudokuNumber[SIZE_BOARD*SIZE_BOARD];
-	squares_ = new square[SIZE_SQUARE*SIZE_SQUARE];
-	sameNumbers_ = new std::list<sudokuNumber*>();
+	try {
+		init();
+		getSudokuProblem(filename);
+		start();
+	}
+	catch (...)
+	{
+		release();
+		throw;
+	}
+}
 
-	gameWon = false;
-	reset();
 
-	for (int i = 0; i < SIZE_SQUARE; i++)
-	{
-		for (int j = 0; j < SIZE_SQUARE; j++)
+Sudoku::Sudoku(const PuzzleLibrary& library, int index)
+{
+	try {
+		init();
+
+		if (index < 0 || index >= library.getCount())
 		{
-			squares_[i*SIZE_SQUARE + j].indexRow = i * SIZE_SQUARE;
-			squares_[i*SIZE_SQUARE + j].indexColumn = j * SIZE_SQUARE;
+			throw std::invalid_argument("The puzzle isn't in library!");
 		}
+
+		if (!library.getBoard(index, solutionBoard_))
+		{
+			throw std::invalid_argument("The puzzle in library is damaged!");
+		}
+
+		start();
+	}
+	catch (...)
+	{
+		release();
+		throw;
 	}
+}
 
-	getSudokuProblem("text.txt");
-	copyNumbers();
-	findSolution();
+
+Sudoku::Sudoku(const builtinPuzzle& puzzle)
+{
+	try {
+		init();
+		memcpy(solutionBoard_, puzzle.problem, sizeof(puzzle.problem));
+		copyNumbers();
+		memcpy(solutionBoard_, puzzle.solution, sizeof(puzzle.solution));
+	}
+	catch (...)
+	{
+		release();
+		throw;
+	}
 }
 
 
 Sudoku::~Sudoku()
 {
-	delete[] solutionBoard_;
-	delete[] playBoard_;
-	delete[] squares_;
-	delete sameNumbers_;
+	release();
 }
 
 
@@ -45,165 +74,295 @@ int Sudoku::getValueAtIndex(int x, int y) const
 
 void Sudoku::setValue(int value, int x, int y)
 {
-	playBoard_[y*SIZE_BOARD + x].value = value;
+	int cell = y*SIZE_BOARD + x;
+	std::uint16_t bit = static_cast<std::uint16_t>(1 << value);
+
+	hash_ = Zobrist::update(hash_, cell, playBoard_[cell].value, value);
+	playBoard_[cell].value = value;
+	notes_[cell] = 0;
+	changed_[cell] = true;
+
+	const std::uint8_t* peers = rules_->getPeers(cell);
+
+	for (int i = 0; i < rules_->getPeerCount(cell); i++)
+	{
+		int peer = peers[i];
+
+		if (value != 0 && (notes_[peer] & bit))
+		{
+			notes_[peer] &= ~bit;
+			changed_[peer] = true;
+		}
+	}
 }
 
 
-const std::list<sudokuNumber*>* Sudoku::getSameNumbers() const
+std::uint16_t Sudoku::getNotes(int x, int y) const
 {
-	return sameNumbers_;
+	return notes_[y*SIZE_BOARD + x];
 }
 
 
-void Sudoku::removeFromSameNumbers()
+void Sudoku::toggleNote(int value, int x, int y)
 {
-	auto iterator = sameNumbers_->begin();
-	sameNumbers_->erase(iterator);
+	int cell = y*SIZE_BOARD + x;
+
+	if (playBoard_[cell].value == 0)
+	{
+		notes_[cell] ^= 1 << value;
+		changed_[cell] = true;
+	}
 }
 
 
-void Sudoku::copyNumbers()
+void Sudoku::fillNotes()
 {
-	for (int i = 0; i < SIZE_BOARD; i++)
+	int board[81];
+	variantState state;
+
+	for (int cell = 0; cell < SIZE_BOARD*SIZE_BOARD; cell++)
 	{
-		for (int j = 0; j < SIZE_BOARD; j++)
+		board[cell] = playBoard_[cell].value;
+	}
+
+	// Wrong numbers of player are placed too, they only remove more notes
+	state.load(*rules_, board);
+
+	for (int cell = 0; cell < SIZE_BOARD*SIZE_BOARD; cell++)
+	{
+		std::uint16_t notes = playBoard_[cell].value == 0 ? state.getCandidates(cell) : 0;
+
+		if (notes_[cell] != notes)
 		{
-			int number = solutionBoard_[i*SIZE_BOARD + j];
-			playBoard_[i*SIZE_BOARD + j] = sudokuNumber{ number, i , j, number != 0 ? false : true };
+			notes_[cell] = notes;
+			changed_[cell] = true;
 		}
 	}
 }
 
 
-bool Sudoku::isValueValid(int value, int x, int y, bool fillNumbers)
+bool Sudoku::isNumberChanged(int x, int y) const
 {
-	if (sameNumbers_->size() > 0)
-	{
-		delete sameNumbers_;
-	}
+	return changed_[y*SIZE_BOARD + x];
+}
 
-	if (!fillNumbers)
+
+void Sudoku::clearChanges()
+{
+	memset(changed_, 0, sizeof(bool) * SIZE_BOARD * SIZE_BOARD);
+}
+
+
+std::uint64_t Sudoku::getHash() const
+{
+	return hash_;
+}
+
+
+void Sudoku::getPuzzle(int* problem, int* solution) const
+{
+	for (int cell = 0; cell < SIZE_BOARD*SIZE_BOARD; cell++)
 	{
-		sameNumbers_ = new std::list<sudokuNumber*>();
-		//sameNumbersCount = 0;
+		problem[cell] = playBoard_[cell].editable ? 0 : playBoard_[cell].value;
+		solution[cell] = solutionBoard_[cell];
 	}
-	
-	return isValueValidInRow(value, x, y, fillNumbers)
-		& isValueValidInColumn(value, x, y, fillNumbers)
-		& isValueValidInSquare(value, x, y, fillNumbers);
 }
 
 
-bool Sudoku::isValueValidInRow(int value, int x, int y, bool fillNumbers)
+const PuzzleRules& Sudoku::getRules() const
+{
+	return *rules_;
+}
+
+
+const std::list<sudokuNumber*>* Sudoku::getSameNumbers() const
+{
+	return sameNumbers_;
+}
+
+
+void Sudoku::removeFromSameNumbers()
+{
+	auto iterator = sameNumbers_->begin();
+	sameNumbers_->erase(iterator);
+}
+
+
+void Sudoku::init()
+{
+	solutionBoard_ = nullptr;
+	playBoard_ = nullptr;
+	rules_ = nullptr;
+	notes_ = nullptr;
+	changed_ = nullptr;
+	sameNumbers_ = nullptr;
+
+	solutionBoard_ = new int[SIZE_BOARD*SIZE_BOARD];
+	playBoard_ = new sudokuNumber[SIZE_BOARD*SIZE_BOARD];
+	rules_ = new PuzzleRules();
+	notes_ = new std::uint16_t[SIZE_BOARD*SIZE_BOARD];
+	changed_ = new bool[SIZE_BOARD*SIZE_BOARD];
+	sameNumbers_ = new std::list<sudokuNumber*>();
+
+	gameWon = false;
+	reset();
+}
+
+
+void Sudoku::release()
 {
-	for (int column = 0; column < SIZE_BOARD; column++)
+	delete[] solutionBoard_;
+	delete[] playBoard_;
+	delete rules_;
+	delete[] notes_;
+	delete[] changed_;
+	delete sameNumbers_;
+
+	solutionBoard_ = nullptr;
+	playBoard_ = nullptr;
+	rules_ = nullptr;
+	notes_ = nullptr;
+	changed_ = nullptr;
+	sameNumbers_ = nullptr;
+}
+
+
+void Sudoku::start()
+{
+	copyNumbers();
+
+	solveBudget budget;
+	solveStats stats;
+	budget.maxNodes = MAX_SOLVE_NODES;
+
+	switch (solve(budget, stats))
 	{
-		if (fillNumbers && 
-			solutionBoard_[y*SIZE_BOARD + column] == value)
-		{
-			return false;
-		}
-		else if (!fillNumbers && y*SIZE_BOARD + x != y*SIZE_BOARD + column &&
-			playBoard_[y*SIZE_BOARD + column].value == value)
-		{
-			sameNumbers_->push_back(&playBoard_[y*SIZE_BOARD + column]);
-			return false;
-		}
+	case SolveResult::SOLVED:
+		break;
+	case SolveResult::BUDGET_EXHAUSTED:
+		throw std::runtime_error("The sudoku is too hard to solve!");
+	default:
+		throw std::runtime_error("The sudoku has no solution!");
 	}
-
-	return true;
 }
 
 
-bool Sudoku::isValueValidInColumn(int value, int x, int y, bool fillNumbers)
+void Sudoku::copyNumbers()
 {
-	for (int row = 0; row < SIZE_BOARD; row++)
+	hash_ = Zobrist::getHash(solutionBoard_);
+
+	for (int i = 0; i < SIZE_BOARD; i++)
 	{
-		if (fillNumbers && 
-			solutionBoard_[row*SIZE_BOARD + x] == value)
-		{
-			return false;
-		}
-		else if (!fillNumbers && y*SIZE_BOARD + x != row*SIZE_BOARD + x &&
-			playBoard_[row*SIZE_BOARD + x].value == value)
+		for (int j = 0; j < SIZE_BOARD; j++)
 		{
-			sameNumbers_->push_back(&playBoard_[row*SIZE_BOARD + x]);
-			return false;
+			int number = solutionBoard_[i*SIZE_BOARD + j];
+			playBoard_[i*SIZE_BOARD + j] = sudokuNumber{ number, i , j, number != 0 ? false : true };
 		}
 	}
-
-	return true;
 }
 
 
-bool Sudoku::isValueValidInSquare(int value, int x, int y, bool fillNumbers)
+bool Sudoku::isValueValid(int value, int x, int y, bool fillNumbers)
 {
-	int srib = y / SIZE_SQUARE;
-	int scib = x / SIZE_SQUARE;
-	int squareRow = squares_[srib*SIZE_SQUARE + scib].indexRow;
-	int squareColumn = squares_[srib*SIZE_SQUARE + scib].indexColumn;
+	if (!fillNumbers)
+	{
+		sameNumbers_->clear();
+	}
 
-	for (int row = 0; row < SIZE_SQUARE; row++)
+	int cell = y*SIZE_BOARD + x;
+	const std::uint8_t* units = rules_->getUnitsOfCell(cell);
+	bool valid = true;
+
+	for (int i = 0; i < rules_->getUnitCountOfCell(cell); i++)
 	{
-		for (int column = 0; column < SIZE_SQUARE; column++)
+		const ruleUnit& unit = rules_->getUnit(units[i]);
+		int sum = value;
+
+		for (int j = 0; j < unit.size; j++)
 		{
-			
-			if (fillNumbers && 
-				solutionBoard_[(squareRow + row)*SIZE_BOARD + (squareColumn + column)] == value)
+			int other = unit.cells[j];
+
+			if (fillNumbers && solutionBoard_[other] == value)
 			{
 				return false;
 			}
-			else if (!fillNumbers && y*SIZE_BOARD + x != (squareRow + row)*SIZE_BOARD + (squareColumn + column) &&
-				playBoard_[(squareRow + row)*SIZE_BOARD + (squareColumn + column)].value == value)
+			else if (!fillNumbers && other != cell && playBoard_[other].value == value)
+			{
+				sameNumbers_->push_back(&playBoard_[other]);
+				valid = false;
+				break;
+			}
+
+			sum += other != cell ? (fillNumbers ? solutionBoard_[other] : playBoard_[other].value) : 0;
+		}
+
+		// Numbers of the cage are wrong together if they exceed its sum
+		if (unit.sum > 0 && sum > unit.sum)
+		{
+			for (int j = 0; !fillNumbers && j < unit.size; j++)
+			{
+				if (unit.cells[j] != cell && playBoard_[unit.cells[j]].value != 0)
+				{
+					sameNumbers_->push_back(&playBoard_[unit.cells[j]]);
+				}
+			}
+
+			if (fillNumbers)
 			{
-				sameNumbers_->push_back(&playBoard_[(squareRow + row) * SIZE_BOARD + (squareColumn + column)]);
 				return false;
 			}
+
+			valid = false;
 		}
 	}
 
-	return true;
+	return valid;
 }
 
 
-bool Sudoku::getNextEmptySolPosition(int& x, int& y) const
+SolveResult Sudoku::solve(const solveBudget& budget, solveStats& stats)
 {
-	for (y = 0; y < SIZE_BOARD; y++)
+	return findSolution(budget, stats);
+}
+
+
+SolveResult Sudoku::findSolution(const solveBudget& budget, solveStats& stats)
+{
+	if (!rules_->isClassic())
 	{
-		for (x = 0; x < SIZE_BOARD; x++)
+		variantState state;
+
+		if (!state.load(*rules_, solutionBoard_))
 		{
-			if (solutionBoard_[y*SIZE_BOARD + x] == 0)
-				return true;
+			return SolveResult::UNSOLVABLE;
 		}
+
+		SolveResult result = VariantSolver().solve(state, budget, stats);
+		if (result == SolveResult::SOLVED)
+		{
+			state.store(solutionBoard_);
+		}
+
+		return result;
 	}
-	
-	return false;
-}
 
+	searchState state;
+	searchOptions options;
 
-bool Sudoku::findSolution()
-{
-	int row, col;
-	
-	if (!getNextEmptySolPosition(col, row))
+	if (!state.load(solutionBoard_))
 	{
-		return true;
+		return SolveResult::UNSOLVABLE;
 	}
-	
-	for (int i = 1; i <= SIZE_BOARD; i++)
-	{
-		if (isValueValid(i, col, row))
-		{
-			solutionBoard_[row*SIZE_BOARD + col] = i;
-
-			if (findSolution())
-				return true;
 
-			solutionBoard_[row*SIZE_BOARD + col] = 0;
-		}
+	// Most puzzles are solved by propagation alone and the rest need few nodes
+	options.propagation = true;
+	SolveResult result = Solver(options).solve(state, budget, stats);
+	if (result == SolveResult::SOLVED)
+	{
+		state.store(solutionBoard_);
 	}
 
-	return false;
+	return result;
 }
 
 
@@ -211,14 +370,17 @@ void Sudoku::reset()
 {
 	memset(solutionBoard_, 0, sizeof(int) * SIZE_BOARD * SIZE_BOARD);
 	memset(playBoard_, 0, sizeof(sudokuNumber) * SIZE_BOARD * SIZE_BOARD);
-	memset(squares_, 0, sizeof(square)*SIZE_SQUARE*SIZE_SQUARE);
+	rules_->reset();
+	memset(notes_, 0, sizeof(std::uint16_t) * SIZE_BOARD * SIZE_BOARD);
+	memset(changed_, 0, sizeof(bool) * SIZE_BOARD * SIZE_BOARD);
+	hash_ = 0;
 }
 
 
 void Sudoku::getSudokuProblem(std::string filename)
 {
 	std::ifstream file;
-	std::string text;
+	std::stringstream text;
 
 	file.open(filename);
 	if (!file.is_open())
@@ -226,43 +388,10 @@ void Sudoku::getSudokuProblem(std::string filename)
 		throw std::invalid_argument("The file doesn't exist!");
 	}
 
-	while (!file.eof())
-	{
-		int row;
-		int column;
-		int value;
-		
-		file >> text;
-		getDataFromString(text, row, column, value);
-		solutionBoard_[row*SIZE_BOARD + column] = value;
-	}
-}
-
-
-void Sudoku::getDataFromString(std::string str, int & row, int & column, int & value)
-{ 
-	std::stringstream ss(str);
-	char letter;
-	int i = 0;
-
-	while (ss >> letter)
+	text << file.rdbuf();
+	if (!PuzzleFormat::parse(text.str(), solutionBoard_, *rules_))
 	{
-		if (letter >= '0' && letter <= '9')
-		{
-			switch (i)
-			{
-			case 0:
-				row = letter - '0';
-				i++;
-				break;
-			case 1:
-				column = letter - '0';
-				i++;
-				break;
-			case 2:
-				value = letter - '0';
-			}
-		}
+		throw std::invalid_argument("The file has invalid format!");
 	}
 }
 
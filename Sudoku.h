@@ -5,17 +5,15 @@
 #include <string>
 #include <sstream>
 #include <list>
-
-
-/*
-	Represents every square that contains 9x9 numbers
-	with specific init position
-*/
-struct square
-{
-	int indexRow;
-	int indexColumn;
-};
+#include <cstring>
+#include <cstdint>
+#include "Solver.h"
+#include "PuzzleFormat.h"
+#include "PuzzleLibrary.h"
+#include "BuiltinPuzzles.h"
+#include "Zobrist.h"
+#include "PuzzleRules.h"
+#include "VariantSolver.h"
 
 
 /*
@@ -36,7 +34,29 @@ struct sudokuNumber
 class Sudoku
 {
 public:
-	Sudoku();
+	/*
+		Creates game with puzzle from text file, the file may
+		contain rule lines of variants
+
+		@param filename Name of the file
+	*/
+	Sudoku(const std::string& filename);
+
+	/*
+		Creates game with puzzle from library
+
+		@param library Opened library
+		@param index Index of the puzzle in library
+	*/
+	Sudoku(const PuzzleLibrary& library, int index);
+
+	/*
+		Creates game with built-in puzzle, its solution is already
+		known so nothing is read or searched
+
+		@param puzzle Built-in puzzle
+	*/
+	Sudoku(const builtinPuzzle& puzzle);
 	~Sudoku();
 
 	/*
@@ -58,8 +78,70 @@ public:
 	void setValue(int value, int x, int y);
 
 	/*
-		Get list of numbers that are the same in the row,
-		column and square
+		Get candidate notes of sudoku number at specific position
+
+		@param x Horizontal position in board
+		@param y Vertical position in board
+		@return Bitmask of notes, bit 1 represents value 1
+	*/
+	std::uint16_t getNotes(int x, int y) const;
+
+	/*
+		Toggles candidate note of empty sudoku number
+
+		@param value Value of the note
+		@param x Horizontal position in board
+		@param y Vertical position in board
+	*/
+	void toggleNote(int value, int x, int y);
+
+	/*
+		Fills notes of every empty number with values that
+		aren't used by its peers
+	*/
+	void fillNotes();
+
+	/*
+		Checks if the number or its notes changed since the
+		last clearing of changes
+
+		@param x Horizontal position in board
+		@param y Vertical position in board
+		@return If the number changed
+	*/
+	bool isNumberChanged(int x, int y) const;
+
+	/*
+		Marks every number as unchanged
+	*/
+	void clearChanges();
+
+	/*
+		Get Zobrist hash of numbers in playing board, it's kept
+		up to date by every change of number
+
+		@return Hash of the playing board
+	*/
+	std::uint64_t getHash() const;
+
+	/*
+		Get given numbers and solution of the puzzle
+
+		@param problem Board where the given numbers are written
+		@param solution Board where the solution is written
+	*/
+	void getPuzzle(int* problem, int* solution) const;
+
+	/*
+		Get rules of the loaded puzzle
+
+		@return Compiled rules
+	*/
+	const PuzzleRules& getRules() const;
+
+	/*
+		Get list of numbers that are the same in any unit of
+		the rules or that break sum of cage
 		@return list of the same numbers
 	*/
 	const std::list<sudokuNumber*>* getSameNumbers() const;
@@ -126,65 +208,52 @@ public:
 	*/
 	bool checkPlayerSolution() const;
 
+	/*
+		Finds solution of loaded problem within given limits,
+		if the solution isn't found the solution board is
+		restored to the given numbers
+
+		@param budget Limits of the solving
+		@param stats Statistics gathered so far
+		@return Result of the solving
+	*/
+	SolveResult solve(const solveBudget& budget, solveStats& stats);
+
 	/*
 		Sets containers to zeros
 	*/
 	void reset();
 private:
 	/*
-		Copy numbers from solution into playing board
-	*/
-	void copyNumbers();
-	
-	/*
-		Checks if the specific value is valid in row
-
-		@param value New value
-		@param x Horizontal position in board
-		@param y Vertical position in board
-		@param fillNumbers Decides what board used
-		@return if the value is valid
+		Allocates containers and sets them to zeros
 	*/
-	bool isValueValidInRow(int value, int x, int y, bool fillNumbers);
+	void init();
 
 	/*
-		Checks if the specific value is valid in column
-
-		@param value New Value
-		@param x Horizontal position of board
-		@param y Vertical position of board
-		@param fillNumbers Decides what board used
-		@return if the value is valid
+		Frees containers, it's safe to call it more times
 	*/
-	bool isValueValidInColumn(int value, int x, int y, bool fillNumbers);
+	void release();
 
 	/*
-		Checks if the specific value is valid in square
-
-		@param value New value
-		@param x Horizontal position in board
-		@param y Vertical position in board
-		@param fillNumbers Decides what board used
-		@return if the value is valid
+		Copies loaded problem into playing board and finds
+		its solution
 	*/
-	bool isValueValidInSquare(int value, int x, int y, bool fillNumbers);
+	void start();
 
 	/*
-		Checks if there is empty position in solution board and
-		then returns it's position to ref params
-
-		@param x Horizontal position of empty position
-		@param y Vertical position of empty position
-		@return if there is any empty position
+		Copy numbers from solution into playing board
 	*/
-	bool getNextEmptySolPosition(int& x, int& y) const;
-
+	void copyNumbers();
+	
 	/*
-		Finds solution using recursive method
+		Finds solution using iterative search of solver with constraint
+		propagation, variant rules are searched by variant solver
 
-		@return If the recursive is done
+		@param budget Limits of the solving
+		@param stats Statistics of the solving
+		@return Result of the search
 	*/
-	bool findSolution();
+	SolveResult findSolution(const solveBudget& budget, solveStats& stats);
 
 	/*
 		Loads sudoku problem from file
@@ -192,20 +261,10 @@ private:
 		@param filename Name of specific file
 	*/
 	void getSudokuProblem(std::string filename);
-
-	/*
-		Extracts indexes with specific values from string
-		to ref variables
-
-		@param str String with data
-		@param row Index of row from string
-		@param column Index of column from string
-		@param value Value from string
-	*/
-	void getDataFromString(std::string str, int& row, int& column, int& value);
 public:
 	const static int SIZE_BOARD;
 	const static int SIZE_SQUARE;
+	const static long long MAX_SOLVE_NODES;
 private:
 	// Represents board for finding solution
 	int* solutionBoard_;
@@ -213,8 +272,14 @@ private:
 	std::list<sudokuNumber*>* sameNumbers_;
 	// Represents board for player's solution
 	sudokuNumber* playBoard_;
-	// Represents order cells in 3x3 squares
-	square* squares_;
+	// Represents compiled rules of the puzzle
+	PuzzleRules* rules_;
+	// Represents candidate notes of numbers in playing board
+	std::uint16_t* notes_;
+	// Represents numbers that changed since the last redraw
+	bool* changed_;
+	// Represents Zobrist hash of playing board
+	std::uint64_t hash_;
 	// Represents if the game is won
 	bool gameWon;
 };
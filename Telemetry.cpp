@@ -0,0 +1,267 @@
+#include "Telemetry.h"
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+const std::uint64_t Telemetry::DEFAULT_FILE_SIZE = 1 << 20;
+const int Telemetry::DEFAULT_FILE_COUNT = 4;
+const int Telemetry::RING_CAPACITY = 4096;
+const int Telemetry::FLUSH_INTERVAL_MS = 50;
+
+namespace
+{
+	const char MAGIC[8] = { 'S', 'U', 'D', 'O', 'T', 'E', 'L', 'E' };
+	const std::uint32_t VERSION = 1;
+
+	// Represents beginning of every telemetry file
+	struct telemetryHeader
+	{
+		char magic[8];
+		std::uint32_t version;
+		std::uint32_t eventSize;
+	};
+
+	static_assert(sizeof(telemetryEvent) == 32, "Event layout is part of the file format");
+	static_assert(sizeof(telemetryHeader) == 16, "Header layout is part of the file format");
+
+	bool isValidHeader(const telemetryHeader& header)
+	{
+		return memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == VERSION &&
+			header.eventSize == sizeof(telemetryEvent);
+	}
+
+	std::uint64_t getMicroseconds(std::chrono::steady_clock::duration duration)
+	{
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+	}
+}
+
+
+Telemetry::Telemetry(const std::string& filename, std::uint64_t maxFileSize, int maxFiles)
+	: ring_(RING_CAPACITY)
+{
+	filename_ = filename;
+	maxFileSize_ = maxFileSize;
+	maxFiles_ = maxFiles > 0 ? maxFiles : 1;
+	session_ = 0;
+	dropped_ = 0;
+	stopping_ = false;
+
+	std::ifstream existing(filename_, std::ios::binary | std::ios::ate);
+	telemetryHeader header;
+	fileSize_ = existing.is_open() ? static_cast<std::uint64_t>(existing.tellg()) : 0;
+	bool isReadable = fileSize_ >= sizeof(header) && existing.seekg(0) &&
+		existing.read(reinterpret_cast<char*>(&header), sizeof(header));
+	existing.close();
+
+	// Sessions of previous runs are continued in the same file if its format
+	// matches and no event was cut off, other files are kept as rotated copy
+	if (isReadable && isValidHeader(header) && (fileSize_ - sizeof(header)) % sizeof(telemetryEvent) == 0)
+	{
+		file_.open(filename_, std::ios::binary | std::ios::app);
+	}
+	else if (fileSize_ > 0)
+	{
+		rotate();
+	}
+	else
+	{
+		create();
+	}
+
+	flusher_ = std::thread(&Telemetry::flushLoop, this);
+}
+
+
+Telemetry::~Telemetry()
+{
+	endSession();
+	stopping_.store(true, std::memory_order_release);
+	flusher_.join();
+}
+
+
+void Telemetry::startSession(std::uint64_t puzzle)
+{
+	std::random_device device;
+
+	endSession();
+	sessionStart_ = std::chrono::steady_clock::now();
+	lastMove_ = sessionStart_;
+	session_ = (static_cast<std::uint64_t>(device()) << 32 | device()) ^ sessionStart_.time_since_epoch().count();
+	session_ = session_ != 0 ? session_ : 1;
+	push(TelemetryKind::SESSION_START, 0, 0, 0, puzzle);
+}
+
+
+void Telemetry::recordMove(int cell, int value, int conflicts)
+{
+	push(TelemetryKind::MOVE, cell, value, conflicts, 0);
+}
+
+
+void Telemetry::recordNote(int cell, int value)
+{
+	push(TelemetryKind::NOTE, cell, value, 0, 0);
+}
+
+
+void Telemetry::recordWin()
+{
+	push(TelemetryKind::WIN, 0, 0, 0, 0);
+}
+
+
+void Telemetry::endSession()
+{
+	if (session_ != 0)
+	{
+		push(TelemetryKind::SESSION_END, 0, 0, 0, 0);
+		session_ = 0;
+	}
+}
+
+
+long long Telemetry::getDroppedCount() const
+{
+	return dropped_.load(std::memory_order_relaxed);
+}
+
+
+bool Telemetry::read(const std::string& filename, std::vector<telemetryEvent>& events)
+{
+	std::ifstream file(filename, std::ios::binary);
+	telemetryHeader header;
+
+	if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || !isValidHeader(header))
+	{
+		return false;
+	}
+
+	telemetryEvent event;
+	while (file.read(reinterpret_cast<char*>(&event), sizeof(event)))
+	{
+		events.push_back(event);
+	}
+
+	return true;
+}
+
+
+void Telemetry::push(TelemetryKind kind, int cell, int value, int conflicts, std::uint64_t puzzle)
+{
+	if (session_ == 0)
+	{
+		return;
+	}
+
+	auto now = std::chrono::steady_clock::now();
+	telemetryEvent event;
+
+	event.session = session_;
+	event.time = getMicroseconds(now - sessionStart_);
+	event.puzzle = puzzle;
+	event.duration = static_cast<std::uint32_t>(getMicroseconds(now - lastMove_));
+	event.kind = kind;
+	event.cell = static_cast<std::uint8_t>(cell);
+	event.value = static_cast<std::uint8_t>(value);
+	event.conflicts = static_cast<std::uint8_t>(conflicts < 255 ? conflicts : 255);
+
+	if (kind == TelemetryKind::MOVE)
+	{
+		lastMove_ = now;
+	}
+
+	if (!ring_.tryPush(event))
+	{
+		dropped_.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+
+void Telemetry::flushLoop()
+{
+	std::vector<telemetryEvent> batch(ring_.getCapacity());
+
+	while (true)
+	{
+		// Events pushed before stopping was requested are still written
+		bool stopping = stopping_.load(std::memory_order_acquire);
+		size_t count = 0;
+
+		while (count < batch.size() && ring_.tryPop(batch[count]))
+		{
+			count++;
+		}
+
+		if (count > 0)
+		{
+			write(batch.data(), count);
+		}
+
+		if (count == batch.size())
+		{
+			continue;
+		}
+
+		if (stopping)
+		{
+			break;
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(FLUSH_INTERVAL_MS));
+	}
+}
+
+
+void Telemetry::write(const telemetryEvent* events, size_t count)
+{
+	std::uint64_t size = count * sizeof(telemetryEvent);
+
+	if (fileSize_ + size > maxFileSize_ && fileSize_ > sizeof(telemetryHeader))
+	{
+		rotate();
+	}
+
+	if (!file_.is_open())
+	{
+		return;
+	}
+
+	file_.write(reinterpret_cast<const char*>(events), size);
+	file_.flush();
+	fileSize_ += size;
+}
+
+
+void Telemetry::rotate()
+{
+	file_.close();
+
+	for (int i = maxFiles_ - 1; i >= 1; i--)
+	{
+		std::string source = i == 1 ? filename_ : filename_ + "." + std::to_string(i - 1);
+		std::string target = filename_ + "." + std::to_string(i);
+
+		std::remove(target.c_str());
+		std::rename(source.c_str(), target.c_str());
+	}
+
+	create();
+}
+
+
+void Telemetry::create()
+{
+	file_.open(filename_, std::ios::binary | std::ios::trunc);
+	fileSize_ = 0;
+
+	if (file_.is_open())
+	{
+		telemetryHeader header = { { 0 }, VERSION, sizeof(telemetryEvent) };
+
+		memcpy(header.magic, MAGIC, sizeof(MAGIC));
+		file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		fileSize_ = sizeof(header);
+	}
+}
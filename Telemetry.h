@@ -0,0 +1,187 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "EventRing.h"
+
+
+/*
+	Represents kind of telemetry event
+*/
+enum class TelemetryKind : std::uint8_t
+{
+	SESSION_START, MOVE, NOTE, WIN, SESSION_END
+};
+
+
+/*
+	Represents one event as it is written to the file
+*/
+struct telemetryEvent
+{
+	// Random identifier of the game session
+	std::uint64_t session;
+	// Microseconds since the start of the session
+	std::uint64_t time;
+	// Hash of the puzzle for SESSION_START, otherwise 0
+	std::uint64_t puzzle;
+	// Microseconds since the previous move or the start of the session
+	std::uint32_t duration;
+	// Kind of the event
+	TelemetryKind kind;
+	// Index of the cell, 0 if the event has no cell
+	std::uint8_t cell;
+	// Entered value
+	std::uint8_t value;
+	// Count of the same numbers found by the move
+	std::uint8_t conflicts;
+};
+
+
+/*
+	Represents recording of game sessions, events are pushed into
+	lock-free ring and a background thread writes them to rotating
+	files, so the game loop never waits for the disk, events that
+	don't fit into full ring are dropped and counted
+*/
+class Telemetry
+{
+public:
+	/*
+		Creates telemetry writing into file and its rotated copies
+		"filename.1" .. "filename.<maxFiles - 1>"
+
+		@param filename Name of the current file
+		@param maxFileSize Size in bytes after which the file is rotated
+		@param maxFiles Count of kept files including the current one
+	*/
+	Telemetry(const std::string& filename, std::uint64_t maxFileSize = DEFAULT_FILE_SIZE, int maxFiles = DEFAULT_FILE_COUNT);
+
+	/*
+		Writes remaining events and stops the background thread
+	*/
+	~Telemetry();
+
+	/*
+		Starts new session, the previous one is ended
+
+		@param puzzle Hash of the played puzzle
+	*/
+	void startSession(std::uint64_t puzzle);
+
+	/*
+		Records value entered by player
+
+		@param cell Index of the cell
+		@param value Entered value
+		@param conflicts Count of the same numbers found by the move
+	*/
+	void recordMove(int cell, int value, int conflicts);
+
+	/*
+		Records toggled candidate note
+
+		@param cell Index of the cell
+		@param value Value of the note
+	*/
+	void recordNote(int cell, int value);
+
+	/*
+		Records won game
+	*/
+	void recordWin();
+
+	/*
+		Ends the current session
+	*/
+	void endSession();
+
+	/*
+		Get count of events dropped because the ring was full
+
+		@return count of dropped events
+	*/
+	long long getDroppedCount() const;
+
+	/*
+		Reads every event from telemetry file
+
+		@param filename Name of the file
+		@param events Container where events are appended
+		@return if the file has valid header
+	*/
+	static bool read(const std::string& filename, std::vector<telemetryEvent>& events);
+public:
+	const static std::uint64_t DEFAULT_FILE_SIZE;
+	const static int DEFAULT_FILE_COUNT;
+	const static int RING_CAPACITY;
+	const static int FLUSH_INTERVAL_MS;
+private:
+	Telemetry(const Telemetry&);
+	Telemetry& operator=(const Telemetry&);
+
+	/*
+		Pushes event of the current session
+
+		@param kind Kind of the event
+		@param cell Index of the cell
+		@param value Value of the event
+		@param conflicts Count of conflicts
+		@param puzzle Hash of the puzzle
+	*/
+	void push(TelemetryKind kind, int cell, int value, int conflicts, std::uint64_t puzzle);
+
+	/*
+		Writes events from ring until it's stopped, it runs on
+		the background thread
+	*/
+	void flushLoop();
+
+	/*
+		Writes events into the file and rotates it when it's full
+
+		@param events Written events
+		@param count Count of events
+	*/
+	void write(const telemetryEvent* events, size_t count);
+
+	/*
+		Renames files so the current file becomes the first copy
+		and opens new current file
+	*/
+	void rotate();
+
+	/*
+		Opens empty current file and writes its header
+	*/
+	void create();
+private:
+	// Represents ring between game loop and background thread
+	EventRing<telemetryEvent> ring_;
+	// Represents name of the current file
+	std::string filename_;
+	// Represents size after which the file is rotated
+	std::uint64_t maxFileSize_;
+	// Represents count of kept files
+	int maxFiles_;
+	// Represents opened current file
+	std::ofstream file_;
+	// Represents bytes written into the current file
+	std::uint64_t fileSize_;
+	// Represents identifier of the current session, 0 if there is none
+	std::uint64_t session_;
+	// Represents time of the session start
+	std::chrono::steady_clock::time_point sessionStart_;
+	// Represents time of the last move
+	std::chrono::steady_clock::time_point lastMove_;
+	// Represents count of dropped events
+	std::atomic<long long> dropped_;
+	// Represents request to stop background thread
+	std::atomic<bool> stopping_;
+	// Represents background thread writing the file
+	std::thread flusher_;
+};
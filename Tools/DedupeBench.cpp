@@ -0,0 +1,209 @@
+/*
+	Measures Zobrist hashing and deduplication of boards in the
+	lock-free hash set
+
+	Usage: DedupeBench [--boards n] [--threads n] [--duplicates percent]
+	                   [--seed n]
+
+	Boards are relabelings of a few random grids, so every distinct
+	board is known up front and the count of unique boards tells how
+	many different boards got the same 64-bit hash. Duplicates are
+	copies of boards from anywhere in the stream.
+*/
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../ConcurrentHashSet.h"
+#include "../PuzzleGenerator.h"
+#include "../Solver.h"
+#include "../Zobrist.h"
+
+namespace
+{
+	typedef std::chrono::steady_clock benchClock;
+
+	const int BASE_GRIDS = 64;
+
+	// Represents stream of boards where every position maps to id of distinct board
+	struct boardStream
+	{
+		int grids[BASE_GRIDS][81];
+		long long boards;
+		int duplicates;
+
+		long long getFreshCount() const
+		{
+			long long blocks = boards / 100;
+			long long rest = boards % 100;
+			return blocks * (100 - duplicates) + std::min<long long>(rest, 100 - duplicates);
+		}
+
+		long long getId(long long position) const
+		{
+			long long block = position / 100;
+			long long offset = position % 100;
+
+			if (offset < 100 - duplicates)
+			{
+				return block * (100 - duplicates) + offset;
+			}
+
+			std::uint64_t mixed = static_cast<std::uint64_t>(position) * 0x9E3779B97F4A7C15ULL;
+			return static_cast<long long>((mixed ^ (mixed >> 29)) % static_cast<std::uint64_t>(getFreshCount()));
+		}
+
+		// Relabels the base grid by the permutation with the index in lexicographic order
+		void getBoard(long long id, int* board) const
+		{
+			const int* grid = grids[id % BASE_GRIDS];
+			long long index = id / BASE_GRIDS;
+			int digits[9] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+			int labels[10] = { 0 };
+			int left = 9;
+
+			for (int i = 0; i < 9; i++)
+			{
+				long long factorial = 1;
+				for (int j = 2; j < left; j++)
+				{
+					factorial *= j;
+				}
+
+				int chosen = static_cast<int>(index / factorial);
+				index %= factorial;
+				labels[i + 1] = digits[chosen];
+				memmove(digits + chosen, digits + chosen + 1, (left - chosen - 1) * sizeof(int));
+				left--;
+			}
+
+			for (int cell = 0; cell < 81; cell++)
+			{
+				board[cell] = labels[grid[cell]];
+			}
+		}
+	};
+
+	long long getArgument(int argc, char* argv[], const char* name, long long defaultValue)
+	{
+		for (int i = 1; i + 1 < argc; i++)
+		{
+			if (strcmp(argv[i], name) == 0)
+			{
+				return atoll(argv[i + 1]);
+			}
+		}
+
+		return defaultValue;
+	}
+
+	double getSeconds(benchClock::time_point start)
+	{
+		return std::chrono::duration<double>(benchClock::now() - start).count();
+	}
+
+	void dedupe(const boardStream* stream, ConcurrentHashSet* hashes, long long first, long long last,
+		probeStats* stats, std::mutex* statsMutex)
+	{
+		probeStats local;
+		int board[81];
+
+		for (long long position = first; position < last; position++)
+		{
+			stream->getBoard(stream->getId(position), board);
+			hashes->insert(Zobrist::getHash(board), local);
+		}
+
+		std::lock_guard<std::mutex> lock(*statsMutex);
+		stats->add(local);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	boardStream stream;
+	stream.boards = getArgument(argc, argv, "--boards", 10000000LL);
+	stream.duplicates = static_cast<int>(getArgument(argc, argv, "--duplicates", 10LL));
+	int threadCount = static_cast<int>(getArgument(argc, argv, "--threads", std::thread::hardware_concurrency()));
+	PuzzleGenerator generator(static_cast<std::uint64_t>(getArgument(argc, argv, "--seed", 12345LL)));
+
+	threadCount = threadCount > 0 ? threadCount : 1;
+	if (stream.duplicates < 0 || stream.duplicates > 99 || stream.getFreshCount() > 362880LL * BASE_GRIDS)
+	{
+		std::cerr << "Duplicates have to be 0..99 and there are at most "
+			<< 362880LL * BASE_GRIDS << " distinct boards" << std::endl;
+		return 1;
+	}
+
+	for (int i = 0; i < BASE_GRIDS; i++)
+	{
+		generator.generateGrid(stream.grids[i]);
+	}
+
+	// Full hash of the board against one change followed by O(1) update
+	const long long samples = 1000000;
+	std::uint64_t checksum = 0;
+	int board[81];
+	auto start = benchClock::now();
+
+	for (long long i = 0; i < samples; i++)
+	{
+		stream.getBoard(i, board);
+		checksum ^= Zobrist::getHash(board);
+	}
+
+	double fullSeconds = getSeconds(start);
+	searchState state;
+	state.load(stream.grids[0]);
+	start = benchClock::now();
+
+	for (long long i = 0; i < samples; i++)
+	{
+		int cell = static_cast<int>(i % 81);
+		int value = state.values[cell];
+
+		state.undo(cell);
+		checksum ^= state.hash;
+		state.place(cell, value);
+	}
+
+	double updateSeconds = getSeconds(start);
+
+	std::cout << "Board generation + full hash: " << static_cast<long long>(samples / fullSeconds) << " boards/s" << std::endl;
+	std::cout << "Incremental undo + place: " << static_cast<long long>(samples / updateSeconds) << " updates/s"
+		<< " (checksum " << std::hex << checksum << std::dec << ")" << std::endl;
+
+	ConcurrentHashSet hashes(ConcurrentHashSet::getCapacityFor(static_cast<size_t>(stream.getFreshCount())));
+	probeStats stats;
+	std::mutex statsMutex;
+	std::vector<std::thread> threads;
+
+	start = benchClock::now();
+	for (int i = 0; i < threadCount; i++)
+	{
+		threads.emplace_back(dedupe, &stream, &hashes, stream.boards * i / threadCount,
+			stream.boards * (i + 1) / threadCount, &stats, &statsMutex);
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	double seconds = getSeconds(start);
+	long long unique = static_cast<long long>(hashes.getSize());
+
+	std::cout << "Deduplicated " << stream.boards << " boards on " << threadCount << " threads in "
+		<< seconds << " s (" << static_cast<long long>(stream.boards / seconds) << " boards/s)" << std::endl;
+	std::cout << "Unique: " << unique << " of " << stream.getFreshCount() << " distinct boards, "
+		<< stream.getFreshCount() - unique << " hash collisions" << std::endl;
+	std::cout << "Probing: " << hashes.getSize() << "/" << hashes.getCapacity() << " slots, "
+		<< static_cast<double>(stats.collisions) / stats.inserts << " collisions per insert, the longest probe "
+		<< stats.maxProbe << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,255 @@
+/*
+	Load generator for the solving daemon, every connection keeps
+	up to window requests in flight and measures latency of each
+	request from sending to receiving the reply
+
+	Usage: LoadClient [--socket path] [--connections n] [--requests n]
+	                  [--window n] [--puzzles file]
+
+	The puzzles file contains one puzzle per line in any format
+	accepted by the daemon, built-in puzzles are used without it
+*/
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+	typedef std::chrono::steady_clock loadClock;
+
+	const char* BUILT_IN_PUZZLES[] = {
+		".8....2......84.9...632..1..97....8.8..9.3..2.1....95..7..458...3.71......8....4.",
+		"8..........36......7..9.2...5...7.......457.....1...3...1....68..85...1..9....4..",
+		"1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..",
+		"..53.....8......2..7..1.5..4....53...1..7...6..32...8..6.5....9..4....3......97..",
+	};
+
+	// Represents results of one connection
+	struct connectionResult
+	{
+		std::vector<long long> latencies;
+		long long errors = 0;
+	};
+
+	// Represents sending times of requests waiting for reply
+	struct inFlight
+	{
+		std::deque<loadClock::time_point> sent;
+		std::mutex mutex;
+		std::condition_variable changed;
+		bool closed = false;
+	};
+
+	int connectTo(const std::string& path)
+	{
+		sockaddr_un address;
+		memset(&address, 0, sizeof(address));
+		address.sun_family = AF_UNIX;
+		strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+		int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+		{
+			close(fd);
+			return -1;
+		}
+
+		return fd;
+	}
+
+	void sendRequests(int fd, const std::vector<std::string>* puzzles, long long requests,
+		int window, inFlight* flight)
+	{
+		for (long long i = 0; i < requests; i++)
+		{
+			std::string line = (*puzzles)[i % puzzles->size()] + "\n";
+			{
+				std::unique_lock<std::mutex> lock(flight->mutex);
+				flight->changed.wait(lock, [flight, window] {
+					return flight->closed || flight->sent.size() < static_cast<size_t>(window);
+				});
+
+				if (flight->closed)
+				{
+					return;
+				}
+
+				flight->sent.push_back(loadClock::now());
+			}
+
+			if (write(fd, line.data(), line.size()) != static_cast<ssize_t>(line.size()))
+			{
+				return;
+			}
+		}
+	}
+
+	void runConnection(const std::string& path, const std::vector<std::string>* puzzles,
+		long long requests, int window, connectionResult* result)
+	{
+		int fd = connectTo(path);
+		if (fd < 0)
+		{
+			result->errors += requests;
+			return;
+		}
+
+		inFlight flight;
+		std::thread sender(sendRequests, fd, puzzles, requests, window, &flight);
+		std::string buffer;
+		char chunk[4096];
+		long long received = 0;
+		ssize_t count;
+
+		result->latencies.reserve(static_cast<size_t>(requests));
+		while (received < requests && (count = read(fd, chunk, sizeof(chunk))) > 0)
+		{
+			buffer.append(chunk, static_cast<size_t>(count));
+
+			size_t end;
+			while ((end = buffer.find('\n')) != std::string::npos)
+			{
+				loadClock::time_point sent;
+				{
+					std::lock_guard<std::mutex> lock(flight.mutex);
+					sent = flight.sent.front();
+					flight.sent.pop_front();
+				}
+
+				flight.changed.notify_one();
+				result->latencies.push_back(
+					std::chrono::duration_cast<std::chrono::microseconds>(loadClock::now() - sent).count());
+				result->errors += buffer.compare(0, 7, "SOLVED ") == 0 ? 0 : 1;
+				buffer.erase(0, end + 1);
+				received++;
+			}
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(flight.mutex);
+			flight.closed = true;
+		}
+
+		flight.changed.notify_all();
+		shutdown(fd, SHUT_RDWR);
+		sender.join();
+		close(fd);
+		result->errors += requests - received;
+	}
+
+	long long getArgument(int argc, char* argv[], const char* name, long long defaultValue)
+	{
+		for (int i = 1; i + 1 < argc; i++)
+		{
+			if (strcmp(argv[i], name) == 0)
+			{
+				return atoll(argv[i + 1]);
+			}
+		}
+
+		return defaultValue;
+	}
+
+	std::string getArgument(int argc, char* argv[], const char* name, const std::string& defaultValue)
+	{
+		for (int i = 1; i + 1 < argc; i++)
+		{
+			if (strcmp(argv[i], name) == 0)
+			{
+				return argv[i + 1];
+			}
+		}
+
+		return defaultValue;
+	}
+
+	long long getPercentile(const std::vector<long long>& sorted, double percentile)
+	{
+		if (sorted.empty())
+		{
+			return 0;
+		}
+
+		size_t index = static_cast<size_t>(percentile * (sorted.size() - 1));
+		return sorted[index];
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::string path = getArgument(argc, argv, "--socket", std::string("/tmp/sudoku.sock"));
+	std::string puzzleFile = getArgument(argc, argv, "--puzzles", std::string());
+	int connections = static_cast<int>(getArgument(argc, argv, "--connections", 8LL));
+	long long requests = getArgument(argc, argv, "--requests", 1000LL);
+	int window = static_cast<int>(getArgument(argc, argv, "--window", 4LL));
+	std::vector<std::string> puzzles;
+
+	if (!puzzleFile.empty())
+	{
+		std::ifstream file(puzzleFile);
+		std::string line;
+
+		while (std::getline(file, line))
+		{
+			if (!line.empty())
+			{
+				puzzles.push_back(line);
+			}
+		}
+	}
+	else
+	{
+		puzzles.assign(std::begin(BUILT_IN_PUZZLES), std::end(BUILT_IN_PUZZLES));
+	}
+
+	if (puzzles.empty() || connections < 1 || window < 1)
+	{
+		std::cerr << "Nothing to send" << std::endl;
+		return 1;
+	}
+
+	std::vector<connectionResult> results(static_cast<size_t>(connections));
+	std::vector<std::thread> threads;
+	loadClock::time_point start = loadClock::now();
+
+	for (int i = 0; i < connections; i++)
+	{
+		threads.emplace_back(runConnection, path, &puzzles, requests, window, &results[i]);
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	double seconds = std::chrono::duration<double>(loadClock::now() - start).count();
+	std::vector<long long> latencies;
+	long long errors = 0;
+
+	for (auto& result : results)
+	{
+		latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+		errors += result.errors;
+	}
+
+	std::sort(latencies.begin(), latencies.end());
+	std::cout << "requests:   " << latencies.size() << " (" << errors << " not solved)" << std::endl;
+	std::cout << "throughput: " << static_cast<long long>(latencies.size() / seconds) << " req/s" << std::endl;
+	std::cout << "p50:        " << getPercentile(latencies, 0.50) << " us" << std::endl;
+	std::cout << "p99:        " << getPercentile(latencies, 0.99) << " us" << std::endl;
+	std::cout << "max:        " << getPercentile(latencies, 1.00) << " us" << std::endl;
+
+	return errors == 0 ? 0 : 2;
+}
@@ -0,0 +1,128 @@
+/*
+	Checks if puzzles are minimal and reduces them to minimal form
+
+	Usage: MinimalPuzzle <file> [--threads n] [--reduce]
+
+	The file is read the same way as the game reads text.txt, if the
+	whole file isn't one puzzle every line is taken as one puzzle.
+	For every puzzle the redundant clues are listed as [row,column],
+	a clue is redundant if the solution stays unique without it.
+	With --reduce the minimal puzzle is printed too.
+*/
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../PuzzleFormat.h"
+#include "../PuzzleReducer.h"
+
+namespace
+{
+	void printReport(const minimalityReport& report)
+	{
+		if (!report.unique)
+		{
+			std::cout << "  not unique, minimality is undefined" << std::endl;
+			return;
+		}
+
+		std::cout << "  " << report.clues << " clues, " << report.redundantCount << " redundant";
+
+		for (int cell = 0; cell < 81; cell++)
+		{
+			if (report.redundant[cell])
+			{
+				std::cout << " [" << cell / 9 << "," << cell % 9 << "]";
+			}
+		}
+
+		if (report.undecided > 0)
+		{
+			std::cout << ", " << report.undecided << " undecided";
+		}
+
+		std::cout << std::endl << "  " << (report.redundantCount == 0 && report.undecided == 0 ? "minimal" : "not minimal")
+			<< ", " << report.nodes << " nodes in " << report.elapsedMicroseconds << " us" << std::endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: MinimalPuzzle <file> [--threads n] [--reduce]" << std::endl;
+		return 1;
+	}
+
+	int threads = static_cast<int>(std::thread::hardware_concurrency());
+	bool reduce = false;
+
+	for (int i = 2; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+		{
+			threads = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--reduce") == 0)
+		{
+			reduce = true;
+		}
+	}
+
+	std::ifstream file(argv[1]);
+	std::stringstream text;
+
+	if (!file.is_open())
+	{
+		std::cerr << "Couldn't open " << argv[1] << std::endl;
+		return 1;
+	}
+
+	text << file.rdbuf();
+
+	std::vector<std::vector<int>> puzzles;
+	std::vector<int> board(81);
+
+	if (PuzzleFormat::parse(text.str(), board.data()))
+	{
+		puzzles.push_back(board);
+	}
+	else
+	{
+		std::string line;
+
+		while (std::getline(text, line))
+		{
+			if (PuzzleFormat::parse(line, board.data()))
+			{
+				puzzles.push_back(board);
+			}
+		}
+	}
+
+	PuzzleReducer reducer(threads > 0 ? threads : 1);
+
+	for (const auto& puzzle : puzzles)
+	{
+		std::cout << PuzzleFormat::toLine(puzzle.data()) << std::endl;
+		printReport(reducer.check(puzzle.data()));
+
+		if (reduce)
+		{
+			int minimal[81];
+			minimalityReport report = reducer.reduce(puzzle.data(), minimal);
+
+			if (report.unique)
+			{
+				std::cout << PuzzleFormat::toLine(minimal) << std::endl;
+				printReport(report);
+			}
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,135 @@
+/*
+	Compares the default search with the portfolio on puzzles
+	and reports which strategy wins on each puzzle, the default
+	search is the one of the game, row-major with propagation,
+	so the difference comes only from racing of the strategies
+
+	Usage: PortfolioBench <puzzles.txt> [--timeout-ms n] [--verbose]
+
+	The puzzles file contains one puzzle per line in any format
+	accepted by PuzzleFormat
+*/
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../PortfolioSolver.h"
+#include "../PuzzleFormat.h"
+
+namespace
+{
+	long long getPercentile(const std::vector<long long>& sorted, double percentile)
+	{
+		if (sorted.empty())
+		{
+			return 0;
+		}
+
+		return sorted[static_cast<size_t>(percentile * (sorted.size() - 1))];
+	}
+
+	void printLatencies(const char* name, std::vector<long long>& latencies, int unsolved)
+	{
+		std::sort(latencies.begin(), latencies.end());
+		std::cout << name << ": p50=" << getPercentile(latencies, 0.50)
+			<< "us p99=" << getPercentile(latencies, 0.99)
+			<< "us max=" << getPercentile(latencies, 1.00)
+			<< "us unsolved=" << unsolved << std::endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: PortfolioBench <puzzles.txt> [--timeout-ms n] [--verbose]" << std::endl;
+		return 1;
+	}
+
+	long long timeout = 10000;
+	bool verbose = false;
+
+	for (int i = 2; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--timeout-ms") == 0 && i + 1 < argc)
+		{
+			timeout = atoll(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--verbose") == 0)
+		{
+			verbose = true;
+		}
+	}
+
+	std::ifstream file(argv[1]);
+	std::string line;
+	PortfolioSolver portfolio;
+	searchOptions defaultOptions;
+	const std::vector<portfolioStrategy>& strategies = portfolio.getStrategies();
+	std::vector<int> wins(strategies.size(), 0);
+	std::vector<long long> defaultLatencies;
+	std::vector<long long> portfolioLatencies;
+	int defaultUnsolved = 0;
+	int portfolioUnsolved = 0;
+
+	// The same configuration as Sudoku::findSolution
+	defaultOptions.propagation = true;
+
+	while (std::getline(file, line))
+	{
+		int board[81];
+		searchState state;
+
+		if (!PuzzleFormat::parse(line, board) || !state.load(board))
+		{
+			continue;
+		}
+
+		solveBudget budget;
+		budget.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+
+		searchState defaultState = state;
+		solveStats defaultStats;
+		if (Solver(defaultOptions).solve(defaultState, budget, defaultStats) != SolveResult::SOLVED)
+		{
+			defaultUnsolved++;
+		}
+
+		defaultLatencies.push_back(defaultStats.elapsedMicroseconds);
+
+		budget.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+		portfolioStats stats;
+		if (portfolio.solve(state, budget, stats) != SolveResult::SOLVED)
+		{
+			portfolioUnsolved++;
+		}
+
+		portfolioLatencies.push_back(stats.elapsedMicroseconds);
+
+		if (stats.winner >= 0)
+		{
+			wins[stats.winner]++;
+		}
+
+		if (verbose)
+		{
+			std::cout << PuzzleFormat::toLine(board) << " "
+				<< (stats.winner >= 0 ? strategies[stats.winner].name : std::string("none")) << " "
+				<< stats.elapsedMicroseconds << "us" << std::endl;
+		}
+	}
+
+	std::cout << "puzzles: " << portfolioLatencies.size() << std::endl;
+	printLatencies("default  ", defaultLatencies, defaultUnsolved);
+	printLatencies("portfolio", portfolioLatencies, portfolioUnsolved);
+
+	for (size_t i = 0; i < strategies.size(); i++)
+	{
+		std::cout << "wins " << strategies[i].name << ": " << wins[i] << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,215 @@
+/*
+	Builds and queries puzzle libraries
+
+	Usage: PuzzleLibraryTool build <puzzles.txt> <output.lib>
+	       PuzzleLibraryTool query <input.lib> [--difficulty name] [--clues n]
+	                               [--technique name] [--count n]
+	       PuzzleLibraryTool stats <input.lib>
+
+	The puzzles file contains one puzzle per line, either as 81
+	characters or as "[row,column]:value" entries, unsolvable puzzles
+	and puzzles with the same canonical form are skipped
+*/
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include "../PuzzleFormat.h"
+#include "../PuzzleLibrary.h"
+#include "../Solver.h"
+
+namespace
+{
+	const char* getArgument(int argc, char* argv[], const char* name)
+	{
+		for (int i = 1; i + 1 < argc; i++)
+		{
+			if (strcmp(argv[i], name) == 0)
+			{
+				return argv[i + 1];
+			}
+		}
+
+		return nullptr;
+	}
+
+	int findDifficulty(const char* name)
+	{
+		for (int difficulty = 0; difficulty <= static_cast<int>(Difficulty::EXPERT); difficulty++)
+		{
+			if (strcmp(name, PuzzleRating::getName(static_cast<Difficulty>(difficulty))) == 0)
+			{
+				return difficulty;
+			}
+		}
+
+		return -2;
+	}
+
+	int findTechnique(const char* name)
+	{
+		for (int technique = 0; technique <= static_cast<int>(Technique::GUESSING); technique++)
+		{
+			if (strcmp(name, PuzzleRating::getName(static_cast<Technique>(technique))) == 0)
+			{
+				return technique;
+			}
+		}
+
+		return -2;
+	}
+
+	int build(const char* input, const char* output)
+	{
+		std::ifstream file(input);
+		std::vector<libraryRecord> records;
+		std::unordered_set<std::uint64_t> hashes;
+		std::string line;
+		int skipped = 0;
+
+		if (!file.is_open())
+		{
+			std::cerr << "Couldn't open " << input << std::endl;
+			return 1;
+		}
+
+		while (std::getline(file, line))
+		{
+			int board[81];
+			searchState state;
+			solveBudget budget;
+			solveStats stats;
+
+			if (line.find_first_not_of(" \t\r") == std::string::npos)
+			{
+				continue;
+			}
+
+			budget.maxNodes = 10000000;
+			if (!PuzzleFormat::parse(line, board) || !state.load(board) ||
+				Solver().solve(state, budget, stats) != SolveResult::SOLVED)
+			{
+				skipped++;
+				continue;
+			}
+
+			libraryRecord record = PuzzleLibrary::createRecord(board);
+			if (!hashes.insert(record.canonicalHash).second)
+			{
+				skipped++;
+				continue;
+			}
+
+			records.push_back(record);
+		}
+
+		if (!PuzzleLibrary::write(output, records))
+		{
+			std::cerr << "Couldn't write " << output << std::endl;
+			return 1;
+		}
+
+		std::cout << "Stored " << records.size() << " puzzles, skipped " << skipped << std::endl;
+		return 0;
+	}
+
+	int query(int argc, char* argv[], const char* input)
+	{
+		PuzzleLibrary library;
+		libraryQuery query;
+		std::mt19937 random(std::random_device{}());
+		const char* difficulty = getArgument(argc, argv, "--difficulty");
+		const char* clues = getArgument(argc, argv, "--clues");
+		const char* technique = getArgument(argc, argv, "--technique");
+		const char* count = getArgument(argc, argv, "--count");
+
+		if (!library.open(input))
+		{
+			std::cerr << "Couldn't open library " << input << std::endl;
+			return 1;
+		}
+
+		query.difficulty = difficulty != nullptr ? findDifficulty(difficulty) : -1;
+		query.clues = clues != nullptr ? atoi(clues) : -1;
+		query.technique = technique != nullptr ? findTechnique(technique) : -1;
+
+		if (query.difficulty == -2 || query.technique == -2)
+		{
+			std::cerr << "Unknown difficulty or technique" << std::endl;
+			return 1;
+		}
+
+		std::cout << library.count(query) << " matching puzzles" << std::endl;
+		for (int i = 0; i < (count != nullptr ? atoi(count) : 1); i++)
+		{
+			int index = library.findRandom(query, random);
+			int board[81];
+
+			if (index < 0)
+			{
+				break;
+			}
+
+			const libraryRecord& record = library.getRecord(index);
+			if (!library.getBoard(index, board))
+			{
+				std::cerr << "Puzzle " << index << " is damaged" << std::endl;
+				return 1;
+			}
+
+			std::cout << PuzzleFormat::toLine(board) << " "
+				<< PuzzleRating::getName(static_cast<Difficulty>(record.difficulty)) << " "
+				<< static_cast<int>(record.clues) << " "
+				<< PuzzleRating::getName(static_cast<Technique>(record.hardest)) << std::endl;
+		}
+
+		return 0;
+	}
+
+	int stats(const char* input)
+	{
+		PuzzleLibrary library;
+
+		if (!library.open(input))
+		{
+			std::cerr << "Couldn't open library " << input << std::endl;
+			return 1;
+		}
+
+		std::cout << library.getCount() << " puzzles" << std::endl;
+		for (int difficulty = 0; difficulty <= static_cast<int>(Difficulty::EXPERT); difficulty++)
+		{
+			libraryQuery query;
+			query.difficulty = difficulty;
+			std::cout << PuzzleRating::getName(static_cast<Difficulty>(difficulty)) << ": "
+				<< library.count(query) << std::endl;
+		}
+
+		return 0;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc >= 4 && strcmp(argv[1], "build") == 0)
+	{
+		return build(argv[2], argv[3]);
+	}
+
+	if (argc >= 3 && strcmp(argv[1], "query") == 0)
+	{
+		return query(argc, argv, argv[2]);
+	}
+
+	if (argc >= 3 && strcmp(argv[1], "stats") == 0)
+	{
+		return stats(argv[2]);
+	}
+
+	std::cerr << "Usage: PuzzleLibraryTool build <puzzles.txt> <output.lib>" << std::endl;
+	std::cerr << "       PuzzleLibraryTool query <input.lib> [--difficulty name] [--clues n] [--technique name] [--count n]" << std::endl;
+	std::cerr << "       PuzzleLibraryTool stats <input.lib>" << std::endl;
+	return 1;
+}
@@ -0,0 +1,357 @@
+/*
+	Produces puzzle packs in stages connected by bounded lock-free
+	queues: generate -> reduce -> rate -> dedupe -> store
+
+	Usage: PuzzlePipeline [--count n] [--output file] [--min-clues n]
+	                      [--generate n] [--reduce n] [--rate n] [--dedupe n]
+	                      [--queue n] [--seed n] [--report-ms n]
+
+	Numbers after stage names are thread counts. Output ending with
+	".lib" is written as puzzle library, otherwise as lines of 81
+	characters with difficulty and clue count. Every report shows
+	throughput of stages and depths of queues so the bottleneck is
+	the stage in front of the fullest queue.
+*/
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../BoundedQueue.h"
+#include "../ConcurrentHashSet.h"
+#include "../PuzzleCanonical.h"
+#include "../PuzzleFormat.h"
+#include "../PuzzleGenerator.h"
+#include "../PuzzleLibrary.h"
+
+namespace
+{
+	// Represents puzzle travelling through the pipeline
+	struct pipelineItem
+	{
+		int board[81];
+		puzzleRating rating;
+		std::uint64_t hash;
+	};
+
+	// Represents counters of one stage
+	struct stageCounter
+	{
+		const char* name;
+		int threads;
+		std::atomic<long long> processed;
+	};
+
+	typedef BoundedQueue<pipelineItem> itemQueue;
+
+	std::atomic<bool> stopping(false);
+	// Set when dedupe can't insert any more hashes, the output would have duplicates
+	std::atomic<bool> hashSetFull(false);
+
+	bool pushItem(itemQueue& queue, const pipelineItem& item)
+	{
+		while (!queue.tryPush(item))
+		{
+			if (stopping)
+			{
+				return false;
+			}
+
+			std::this_thread::yield();
+		}
+
+		return true;
+	}
+
+	bool popItem(itemQueue& queue, pipelineItem& item)
+	{
+		while (!queue.tryPop(item))
+		{
+			if (stopping)
+			{
+				return false;
+			}
+
+			std::this_thread::yield();
+		}
+
+		return true;
+	}
+
+	void generate(itemQueue* output, stageCounter* counter, std::uint64_t seed)
+	{
+		PuzzleGenerator generator(seed);
+		pipelineItem item = pipelineItem();
+
+		while (!stopping)
+		{
+			generator.generateGrid(item.board);
+			counter->processed++;
+
+			if (!pushItem(*output, item))
+			{
+				return;
+			}
+		}
+	}
+
+	void reduce(itemQueue* input, itemQueue* output, stageCounter* counter, std::uint64_t seed, int minClues)
+	{
+		PuzzleGenerator generator(seed);
+		pipelineItem item;
+
+		while (popItem(*input, item))
+		{
+			int grid[81];
+
+			memcpy(grid, item.board, sizeof(grid));
+			generator.removeClues(grid, item.board, minClues);
+			counter->processed++;
+
+			if (!pushItem(*output, item))
+			{
+				return;
+			}
+		}
+	}
+
+	void rate(itemQueue* input, itemQueue* output, stageCounter* counter)
+	{
+		pipelineItem item;
+
+		while (popItem(*input, item))
+		{
+			item.rating = PuzzleRating::rate(item.board);
+			counter->processed++;
+
+			if (!pushItem(*output, item))
+			{
+				return;
+			}
+		}
+	}
+
+	void dedupe(itemQueue* input, itemQueue* output, stageCounter* counter, ConcurrentHashSet* hashes,
+		probeStats* stats, std::mutex* statsMutex)
+	{
+		pipelineItem item;
+		probeStats local;
+
+		while (popItem(*input, item))
+		{
+			item.hash = PuzzleCanonical::getCanonicalHash(item.board);
+			counter->processed++;
+
+			InsertResult inserted = hashes->insert(item.hash, local);
+			if (inserted == InsertResult::DUPLICATE)
+			{
+				continue;
+			}
+
+			if (inserted == InsertResult::FULL)
+			{
+				hashSetFull = true;
+				stopping = true;
+				break;
+			}
+
+			if (!pushItem(*output, item))
+			{
+				break;
+			}
+		}
+
+		std::lock_guard<std::mutex> lock(*statsMutex);
+		stats->add(local);
+	}
+
+	void store(itemQueue* input, stageCounter* counter, long long count, std::vector<libraryRecord>* records,
+		std::ostream* text)
+	{
+		pipelineItem item;
+
+		while (counter->processed < count && popItem(*input, item))
+		{
+			if (text != nullptr)
+			{
+				*text << PuzzleFormat::toLine(item.board) << " "
+					<< PuzzleRating::getName(item.rating.difficulty) << " "
+					<< item.rating.clues << "\n";
+			}
+			else
+			{
+				records->push_back(PuzzleLibrary::createRecord(item.board, item.rating, item.hash));
+			}
+
+			counter->processed++;
+		}
+
+		stopping = true;
+	}
+
+	long long getArgument(int argc, char* argv[], const char* name, long long defaultValue)
+	{
+		for (int i = 1; i + 1 < argc; i++)
+		{
+			if (strcmp(argv[i], name) == 0)
+			{
+				return atoll(argv[i + 1]);
+			}
+		}
+
+		return defaultValue;
+	}
+
+	void report(stageCounter* counters, long long* previous, itemQueue** queues, double seconds)
+	{
+		for (int i = 0; i < 5; i++)
+		{
+			long long processed = counters[i].processed;
+
+			std::cout << counters[i].name << "[" << counters[i].threads << "] "
+				<< static_cast<long long>((processed - previous[i]) / seconds) << "/s";
+			previous[i] = processed;
+
+			if (i < 4)
+			{
+				std::cout << " |" << queues[i]->getSize() << "/" << queues[i]->getCapacity() << "| ";
+			}
+		}
+
+		std::cout << std::endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::string output = "puzzles.txt";
+	long long count = getArgument(argc, argv, "--count", 1000LL);
+	int minClues = static_cast<int>(getArgument(argc, argv, "--min-clues", 17LL));
+	long long queueArgument = getArgument(argc, argv, "--queue", 256LL);
+	size_t queueDepth = static_cast<size_t>(queueArgument > 0 ? queueArgument : 0);
+	std::uint64_t seed = static_cast<std::uint64_t>(getArgument(argc, argv, "--seed", 12345LL));
+	long long reportMs = getArgument(argc, argv, "--report-ms", 1000LL);
+
+	for (int i = 1; i + 1 < argc; i++)
+	{
+		if (strcmp(argv[i], "--output") == 0)
+		{
+			output = argv[i + 1];
+		}
+	}
+
+	stageCounter counters[5] = {
+		{ "generate", static_cast<int>(getArgument(argc, argv, "--generate", 1LL)), { 0 } },
+		{ "reduce", static_cast<int>(getArgument(argc, argv, "--reduce", 2LL)), { 0 } },
+		{ "rate", static_cast<int>(getArgument(argc, argv, "--rate", 1LL)), { 0 } },
+		{ "dedupe", static_cast<int>(getArgument(argc, argv, "--dedupe", 2LL)), { 0 } },
+		{ "store", 1, { 0 } },
+	};
+
+	for (const auto& counter : counters)
+	{
+		if (counter.threads < 1)
+		{
+			std::cerr << "Stage " << counter.name << " needs at least 1 thread" << std::endl;
+			return 1;
+		}
+	}
+
+	if (count < 1 || queueDepth < 1)
+	{
+		std::cerr << "Count and queue depth have to be at least 1" << std::endl;
+		return 1;
+	}
+
+	itemQueue generated(queueDepth);
+	itemQueue reduced(queueDepth);
+	itemQueue rated(queueDepth);
+	itemQueue unique(queueDepth);
+	itemQueue* queues[4] = { &generated, &reduced, &rated, &unique };
+	// Only count puzzles and the ones waiting in queues behind dedupe can be inserted
+	ConcurrentHashSet hashes(ConcurrentHashSet::getCapacityFor(static_cast<size_t>(count) + queueDepth + counters[3].threads));
+	probeStats hashStats;
+	std::mutex hashStatsMutex;
+	std::vector<libraryRecord> records;
+	std::ofstream text;
+	bool library = output.size() > 4 && output.compare(output.size() - 4, 4, ".lib") == 0;
+
+	if (!library)
+	{
+		text.open(output);
+		if (!text.is_open())
+		{
+			std::cerr << "Couldn't open " << output << std::endl;
+			return 1;
+		}
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+
+	for (int i = 0; i < counters[0].threads; i++)
+	{
+		threads.emplace_back(generate, &generated, &counters[0], seed * 1000 + i + 1);
+	}
+
+	for (int i = 0; i < counters[1].threads; i++)
+	{
+		threads.emplace_back(reduce, &generated, &reduced, &counters[1], seed * 2000 + i + 1, minClues);
+	}
+
+	for (int i = 0; i < counters[2].threads; i++)
+	{
+		threads.emplace_back(rate, &reduced, &rated, &counters[2]);
+	}
+
+	for (int i = 0; i < counters[3].threads; i++)
+	{
+		threads.emplace_back(dedupe, &rated, &unique, &counters[3], &hashes, &hashStats, &hashStatsMutex);
+	}
+
+	threads.emplace_back(store, &unique, &counters[4], count, &records, library ? nullptr : &text);
+
+	long long previous[5] = { 0 };
+	auto lastReport = start;
+
+	while (!stopping)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+		auto now = std::chrono::steady_clock::now();
+		if (now - lastReport >= std::chrono::milliseconds(reportMs))
+		{
+			report(counters, previous, queues, std::chrono::duration<double>(now - lastReport).count());
+			lastReport = now;
+		}
+	}
+
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	if (hashSetFull)
+	{
+		std::cerr << "Hash set of dedupe is full, stored puzzles could have duplicates" << std::endl;
+		return 1;
+	}
+
+	if (library && !PuzzleLibrary::write(output, records))
+	{
+		std::cerr << "Couldn't write " << output << std::endl;
+		return 1;
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::cout << "Stored " << counters[4].processed << " puzzles in " << seconds << " s ("
+		<< static_cast<long long>(counters[4].processed / seconds) << "/s), "
+		<< hashStats.duplicates << " duplicates dropped" << std::endl;
+	std::cout << "Hash set: " << hashes.getSize() << "/" << hashes.getCapacity() << " slots, "
+		<< hashStats.collisions << " collisions, the longest probe " << hashStats.maxProbe << std::endl;
+
+	return 0;
+}
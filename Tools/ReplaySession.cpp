@@ -0,0 +1,158 @@
+/*
+	Replays recorded game session without terminal
+
+	Usage: ReplaySession <file> [--realtime] [--repeat n]
+
+	The file is session.rec written by the game. Keys go through
+	the same game logic as in the console and the state after every
+	key is compared with the recorded check, so the first differing
+	key points at the change that broke reproduction. Keys pressed
+	while the game watched the solver don't reach the game logic.
+	Without --realtime the keys are fed as fast as possible and the
+	replay is repeated n times to measure keys per second.
+*/
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include "../GameSession.h"
+#include "../SessionRecorder.h"
+#include "../Solver.h"
+
+namespace
+{
+	// Represents outcome of one replay
+	struct replayResult
+	{
+		long long keys = 0;
+		long long mismatches = 0;
+		long long firstMismatch = -1;
+		long long checksum = 0;
+		bool won = false;
+	};
+
+	long long getArgument(int argc, char* argv[], const char* name, long long defaultValue)
+	{
+		for (int i = 1; i + 1 < argc; i++)
+		{
+			if (strcmp(argv[i], name) == 0)
+			{
+				return atoll(argv[i + 1]);
+			}
+		}
+
+		return defaultValue;
+	}
+
+	// The game watches the solver only with classic rules and numbers that don't break them
+	bool isWatched(const Sudoku& sudoku)
+	{
+		int board[81];
+		searchState state;
+
+		for (int cell = 0; cell < 81; cell++)
+		{
+			board[cell] = sudoku.getValueAtIndex(cell % 9, cell / 9);
+		}
+
+		return sudoku.getRules().isClassic() && state.load(board);
+	}
+
+	replayResult replay(const sessionRecording& recording, bool realTime)
+	{
+		Sudoku sudoku(recording.puzzle);
+		GameSession session(sudoku);
+		replayResult result;
+		bool isWatching = false;
+
+		for (const recordedKey& key : recording.keys)
+		{
+			if (realTime)
+			{
+				std::this_thread::sleep_for(std::chrono::microseconds(key.delay));
+			}
+
+			gameStep step = gameStep();
+
+			// Keys read while watching the solver only control the animation
+			if (isWatching)
+			{
+				isWatching = key.key != 'v' && key.key != 27;
+			}
+			else
+			{
+				step = session.handleKey(key.key);
+				isWatching = step.action == GameAction::WATCH && isWatched(sudoku);
+			}
+
+			std::uint64_t hash = session.getStateHash();
+
+			if (static_cast<std::uint32_t>(hash) != key.check)
+			{
+				result.firstMismatch = result.mismatches++ == 0 ? result.keys : result.firstMismatch;
+			}
+
+			result.won |= step.won;
+			result.checksum ^= static_cast<long long>(hash);
+			result.keys++;
+		}
+
+		return result;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: ReplaySession <file> [--realtime] [--repeat n]" << std::endl;
+		return 1;
+	}
+
+	sessionRecording recording;
+	bool realTime = false;
+	long long repeat = getArgument(argc, argv, "--repeat", 1LL);
+
+	for (int i = 2; i < argc; i++)
+	{
+		realTime |= strcmp(argv[i], "--realtime") == 0;
+	}
+
+	if (!SessionRecorder::read(argv[1], recording))
+	{
+		std::cerr << "Couldn't read recording " << argv[1] << std::endl;
+		return 1;
+	}
+
+	replayResult result = replay(recording, realTime);
+	std::cout << result.keys << " keys, " << result.mismatches << " mismatches";
+
+	if (result.firstMismatch >= 0)
+	{
+		std::cout << ", the first after key " << result.firstMismatch << " '" << recording.keys[result.firstMismatch].key << "'";
+	}
+
+	std::cout << (result.won ? ", the game was won" : "") << std::endl;
+
+	if (!realTime && repeat > 0)
+	{
+		long long keys = 0;
+		long long checksum = 0;
+		auto start = std::chrono::steady_clock::now();
+
+		for (long long i = 0; i < repeat; i++)
+		{
+			replayResult timed = replay(recording, false);
+
+			keys += timed.keys;
+			checksum += timed.checksum;
+		}
+
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		std::cout << "Fast-forward: " << keys << " keys in " << seconds << " s ("
+			<< static_cast<long long>(keys / seconds) << " keys/s, checksum " << std::hex << checksum << std::dec << ")" << std::endl;
+	}
+
+	return result.mismatches == 0 ? 0 : 2;
+}
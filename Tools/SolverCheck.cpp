@@ -0,0 +1,733 @@
+/*
+	Runs every solving engine on the same puzzles, compares their
+	answers and checks their speed against stored baseline
+
+	Usage: SolverCheck [--corpus file] [--generated n] [--seed n]
+	                   [--timeout-ms n] [--baseline file]
+	                   [--write-baseline file] [--max-slowdown x]
+	                   [--full-band]
+
+	Generated puzzles are unique puzzles and their copies with few
+	more clues removed, so puzzles with many solutions are checked
+	too. An answer is wrong if the engine misses the solution, finds
+	one that breaks rules or givens, or counts differently. The
+	expected answer comes from the constexpr search, which shares
+	only countBits with the engines, it's computed once per puzzle
+	and its own solution is checked against the rules directly like
+	the answers of the engines. Counting of solutions isn't part of
+	the timing.
+	VariantSolver runs the corpus with classic rules and solves
+	built-in diagonal, jigsaw and killer puzzles with known answers.
+	Every wrong puzzle is shrunk by removing givens while the same
+	engine stays wrong and the smallest reproducer is printed. The share of
+	puzzles solved by propagation alone and the search nodes saved by
+	it are reported for the whole corpus. With --full-band every grid
+	of band 123456789 456789123 789123456 is enumerated and the count
+	must be the known 108374976, which stands for 7802998272 grids,
+	it takes about 3 minutes on one core.
+
+	The baseline file has one line "<engine> <microseconds per
+	puzzle>" per engine. The check fails if any engine is slower than
+	baseline times --max-slowdown, the baseline is comparable only
+	for the same corpus, --generated and --seed. Exit code is 0 only
+	if every answer is right and no engine regressed.
+*/
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../ConstexprSolver.h"
+#include "../GridEnumerator.h"
+#include "../PortfolioSolver.h"
+#include "../PuzzleFormat.h"
+#include "../PuzzleGenerator.h"
+#include "../Solver.h"
+#include "../StepSolver.h"
+#include "../VariantSolver.h"
+
+namespace
+{
+	// Represents answer of one engine
+	struct engineAnswer
+	{
+		SolveResult result;
+		int solution[81];
+		// Count of solutions up to 2, -1 if the engine can't count
+		long long count;
+		// Duration of the solving without the counting, -1 if the whole run is the solving
+		long long microseconds;
+	};
+
+	// Represents one way of solving
+	struct engine
+	{
+		std::string name;
+		std::function<engineAnswer(const int*, const solveBudget&)> run;
+		long long microseconds;
+		int puzzles;
+		int wrong;
+		int exhausted;
+	};
+
+	engineAnswer createAnswer()
+	{
+		engineAnswer answer;
+
+		answer.result = SolveResult::BUDGET_EXHAUSTED;
+		answer.count = -1;
+		answer.microseconds = -1;
+		memset(answer.solution, 0, sizeof(answer.solution));
+
+		return answer;
+	}
+
+	engineAnswer runSolver(const searchOptions& options, const int* board, const solveBudget& budget)
+	{
+		engineAnswer answer = createAnswer();
+		searchState state;
+		solveStats stats;
+
+		state.load(board);
+		searchState counted = state;
+		auto start = std::chrono::steady_clock::now();
+		answer.result = Solver(options).solve(state, budget, stats);
+		answer.microseconds = std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now() - start).count();
+		state.store(answer.solution);
+
+		if (answer.result != SolveResult::BUDGET_EXHAUSTED &&
+			Solver(options).countSolutions(counted, 2, answer.count, budget, stats) == SolveResult::BUDGET_EXHAUSTED)
+		{
+			answer.count = -1;
+		}
+
+		return answer;
+	}
+
+	engineAnswer runPortfolio(const int* board, const solveBudget& budget)
+	{
+		engineAnswer answer = createAnswer();
+		searchState state;
+		portfolioStats stats;
+
+		state.load(board);
+		answer.result = PortfolioSolver().solve(state, budget, stats);
+		state.store(answer.solution);
+
+		return answer;
+	}
+
+	engineAnswer runSteps(const int* board, const solveBudget& budget)
+	{
+		engineAnswer answer = createAnswer();
+		searchState state;
+		solveStep step;
+
+		state.load(board);
+		StepSolver solver(state, searchOptions());
+
+		while (solver.next(step))
+		{
+			if (step.kind == StepKind::SOLVED || step.kind == StepKind::UNSOLVABLE)
+			{
+				answer.result = step.kind == StepKind::SOLVED ? SolveResult::SOLVED : SolveResult::UNSOLVABLE;
+			}
+			else if (Solver::isBudgetExhausted(budget, solver.getStats()))
+			{
+				return answer;
+			}
+		}
+
+		solver.getState().store(answer.solution);
+		return answer;
+	}
+
+	engineAnswer runVariant(const int* board, const solveBudget& budget)
+	{
+		engineAnswer answer = createAnswer();
+		PuzzleRules rules;
+		variantState state;
+		solveStats stats;
+
+		state.load(rules, board);
+		variantState counted = state;
+		auto start = std::chrono::steady_clock::now();
+		answer.result = VariantSolver().solve(state, budget, stats);
+		answer.microseconds = std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now() - start).count();
+		state.store(answer.solution);
+
+		if (answer.result != SolveResult::BUDGET_EXHAUSTED &&
+			VariantSolver().countSolutions(counted, 2, answer.count, budget, stats) == SolveResult::BUDGET_EXHAUSTED)
+		{
+			answer.count = -1;
+		}
+
+		return answer;
+	}
+
+	ConstexprSolver::result solveConstexpr(const int* board)
+	{
+		char text[82] = { 0 };
+
+		for (int cell = 0; cell < 81; cell++)
+		{
+			text[cell] = static_cast<char>('0' + board[cell]);
+		}
+
+		return ConstexprSolver::solve(text);
+	}
+
+	std::vector<engine> getEngines()
+	{
+		std::vector<engine> engines;
+		searchOptions rowMajor;
+		searchOptions minCandidates;
+		searchOptions restarts;
+		searchOptions propagation;
+
+		minCandidates.cellOrder = CellOrder::MIN_CANDIDATES;
+		restarts.cellOrder = CellOrder::RANDOM_MIN_CANDIDATES;
+		restarts.valueOrder = ValueOrder::RANDOM;
+		restarts.restartNodes = 100;
+		propagation.propagation = true;
+
+		engines.push_back(engine{ "row-major", std::bind(runSolver, rowMajor, std::placeholders::_1, std::placeholders::_2), 0, 0, 0, 0 });
+		engines.push_back(engine{ "min-candidates", std::bind(runSolver, minCandidates, std::placeholders::_1, std::placeholders::_2), 0, 0, 0, 0 });
+		engines.push_back(engine{ "restarts", std::bind(runSolver, restarts, std::placeholders::_1, std::placeholders::_2), 0, 0, 0, 0 });
+		engines.push_back(engine{ "restarts+transpositions", [restarts](const int* board, const solveBudget& budget) {
+			TranspositionTable table(TranspositionTable::DEFAULT_CAPACITY);
+			searchOptions options = restarts;
+			options.transpositions = &table;
+			return runSolver(options, board, budget);
+		}, 0, 0, 0, 0 });
+		engines.push_back(engine{ "row-major+propagation", std::bind(runSolver, propagation, std::placeholders::_1, std::placeholders::_2), 0, 0, 0, 0 });
+		propagation.cellOrder = CellOrder::MIN_CANDIDATES;
+		engines.push_back(engine{ "min-candidates+propagation", std::bind(runSolver, propagation, std::placeholders::_1, std::placeholders::_2), 0, 0, 0, 0 });
+		engines.push_back(engine{ "restarts+transpositions+propagation", [restarts](const int* board, const solveBudget& budget) {
+			TranspositionTable table(TranspositionTable::DEFAULT_CAPACITY);
+			searchOptions options = restarts;
+			options.transpositions = &table;
+			options.propagation = true;
+			return runSolver(options, board, budget);
+		}, 0, 0, 0, 0 });
+		engines.push_back(engine{ "portfolio", runPortfolio, 0, 0, 0, 0 });
+		engines.push_back(engine{ "step", runSteps, 0, 0, 0, 0 });
+		engines.push_back(engine{ "variant", runVariant, 0, 0, 0, 0 });
+
+		return engines;
+	}
+
+	// Checks the rules directly, so it doesn't share any code with the engines
+	bool isValidSolution(const int* board, const int* solution)
+	{
+		for (int cell = 0; cell < 81; cell++)
+		{
+			if ((board[cell] != 0 && board[cell] != solution[cell]) || solution[cell] < 1 || solution[cell] > 9)
+			{
+				return false;
+			}
+		}
+
+		for (int unit = 0; unit < 9; unit++)
+		{
+			int rowMask = 0;
+			int columnMask = 0;
+			int squareMask = 0;
+
+			for (int i = 0; i < 9; i++)
+			{
+				rowMask |= 1 << solution[unit * 9 + i];
+				columnMask |= 1 << solution[i * 9 + unit];
+				squareMask |= 1 << solution[(unit / 3 * 3 + i / 3) * 9 + unit % 3 * 3 + i % 3];
+			}
+
+			if (rowMask != 0x3FE || columnMask != 0x3FE || squareMask != 0x3FE)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Represents answer every engine has to agree with
+	struct reference
+	{
+		bool known;
+		long long count;
+		int solution[81];
+	};
+
+	// The constexpr search has its own board and candidates, so a bug in
+	// searchState can't make the reference agree with the engines
+	reference getReference(const int* board)
+	{
+		reference expected;
+		ConstexprSolver::result solved = solveConstexpr(board);
+
+		expected.known = solved.valid;
+		expected.count = solved.count;
+		memcpy(expected.solution, solved.solution, sizeof(expected.solution));
+
+		return expected;
+	}
+
+	// Returns description of the mistake or empty string if the answer is right
+	std::string check(const int* board, const reference& expected, const engineAnswer& answer)
+	{
+		if (answer.result == SolveResult::BUDGET_EXHAUSTED)
+		{
+			return "";
+		}
+
+		if ((answer.result == SolveResult::SOLVED) != (expected.count > 0))
+		{
+			return answer.result == SolveResult::SOLVED ? "solved unsolvable puzzle" : "missed solution";
+		}
+
+		if (answer.result == SolveResult::SOLVED && !isValidSolution(board, answer.solution))
+		{
+			return "invalid solution";
+		}
+
+		if (expected.count == 1 && answer.result == SolveResult::SOLVED &&
+			memcmp(answer.solution, expected.solution, sizeof(expected.solution)) != 0)
+		{
+			return "different unique solution";
+		}
+
+		if (answer.count >= 0 && answer.count != expected.count)
+		{
+			return "counted " + std::to_string(answer.count) + " solutions instead of " + std::to_string(expected.count);
+		}
+
+		return "";
+	}
+
+	std::string findMistake(const engine& solver, const int* board, const reference& expected, long long timeout)
+	{
+		if (!expected.known)
+		{
+			return "";
+		}
+
+		solveBudget budget;
+		budget.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+
+		return check(board, expected, solver.run(board, budget));
+	}
+
+	// Removes givens one by one while the engine stays wrong
+	void shrink(const engine& solver, int* board, long long timeout)
+	{
+		bool removed = true;
+
+		while (removed)
+		{
+			removed = false;
+
+			for (int cell = 0; cell < 81; cell++)
+			{
+				int value = board[cell];
+				if (value == 0)
+				{
+					continue;
+				}
+
+				board[cell] = 0;
+				if (!findMistake(solver, board, getReference(board), timeout).empty())
+				{
+					removed = true;
+				}
+				else
+				{
+					board[cell] = value;
+				}
+			}
+		}
+	}
+
+	// Represents variant puzzle with unique solution, every one of them has
+	// more solutions under classic rules, so ignoring the rules is caught
+	struct variantPuzzle
+	{
+		const char* name;
+		const char* text;
+		const char* solution;
+	};
+
+	const variantPuzzle VARIANT_PUZZLES[] = {
+		{ "diagonal",
+			"..3......4......2.7....3.5....2.1...6..5......4......1.9....6.5....6.9......7....\n"
+			"diagonal\n",
+			"123456789456789123789123456935241867617538294842697531298314675371865942564972318" },
+		{ "jigsaw",
+			"..2....4.9......7....4.1.8......7......8....128........21...3.8......9....6.1....\n"
+			"regions 115229333118223333441222233444155666414555666441555666777888299777888999777188999\n",
+			"812753649943682175675491283154237896369845721287169534521974368438526917796318452" },
+		{ "killer",
+			"..2....4........7.6...........2.7.............8......4......3........9......1....\n"
+			"cage 9 [0,0] [0,1]\ncage 8 [0,4] [0,5]\ncage 9 [2,2] [2,3]\ncage 10 [2,6] [2,7]\n"
+			"cage 9 [4,0] [4,1]\ncage 9 [4,4] [4,5]\ncage 10 [6,2] [6,3]\ncage 9 [6,6] [6,7]\n"
+			"cage 16 [8,0] [8,1]\ncage 9 [8,4] [8,5]\n",
+			"812753649943682175675491283154237896369845721287169534521974368438526917796318452" },
+	};
+
+	// Returns description of the mistake or empty string if VariantSolver finds the known answer
+	std::string checkVariant(const variantPuzzle& puzzle, long long timeout)
+	{
+		PuzzleRules rules;
+		variantState state;
+		solveBudget budget;
+		solveStats stats;
+		int board[81];
+		int expected[81];
+		int solution[81];
+		long long count = 0;
+
+		if (!PuzzleFormat::parse(puzzle.text, board, rules) || !PuzzleFormat::parseLine(puzzle.solution, expected) ||
+			!state.load(rules, board))
+		{
+			return "puzzle isn't valid";
+		}
+
+		budget.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+
+		if (VariantSolver().countSolutions(state, 2, count, budget, stats) == SolveResult::BUDGET_EXHAUSTED)
+		{
+			return "";
+		}
+
+		if (count != 1)
+		{
+			return "counted " + std::to_string(count) + " solutions instead of 1";
+		}
+
+		SolveResult result = VariantSolver().solve(state, budget, stats);
+		if (result == SolveResult::BUDGET_EXHAUSTED)
+		{
+			return "";
+		}
+
+		state.store(solution);
+		if (result != SolveResult::SOLVED || memcmp(solution, expected, sizeof(expected)) != 0)
+		{
+			return "didn't find the known solution";
+		}
+
+		return "";
+	}
+
+	// Represents count of grids completing the first band of FULL_BAND, every one of them
+	// stands for GridEnumerator::SYMMETRY_FACTOR grids
+	const long long FULL_BAND_GRIDS = 108374976;
+	const int FULL_BAND[27] = {
+		1, 2, 3, 4, 5, 6, 7, 8, 9, 4, 5, 6, 7, 8, 9, 1, 2, 3, 7, 8, 9, 1, 2, 3, 4, 5, 6
+	};
+
+	// Returns description of the mistake or empty string if the enumeration of the band finds
+	// the known count, which checks the search and the split by symmetries of lower bands
+	std::string checkFullBand()
+	{
+		GridEnumerator enumerator(static_cast<int>(std::thread::hardware_concurrency()));
+		enumerationStats stats = enumerator.enumerate(FULL_BAND, enumerationLimits(), nullptr);
+
+		std::cout << "Full band: " << stats.grids << " grids in " << stats.elapsedMicroseconds / 1000000.0 << " s" << std::endl;
+
+		if (!stats.complete)
+		{
+			return "the enumeration stopped";
+		}
+
+		if (stats.grids != FULL_BAND_GRIDS)
+		{
+			return "enumerated " + std::to_string(stats.grids) + " grids instead of " + std::to_string(FULL_BAND_GRIDS);
+		}
+
+		return "";
+	}
+
+	// Represents search effort over the corpus with and without propagation
+	struct propagationReport
+	{
+		int puzzles = 0;
+		int withoutBranching = 0;
+		long long searchNodes = 0;
+		long long propagationNodes = 0;
+	};
+
+	void addPropagation(propagationReport& report, const int* board, long long timeout)
+	{
+		searchOptions options;
+		solveBudget budget;
+		solveStats searchStats;
+		solveStats propagationStats;
+		searchState state;
+
+		options.cellOrder = CellOrder::MIN_CANDIDATES;
+		budget.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+		state.load(board);
+
+		searchState propagated = state;
+		bool searched = Solver(options).solve(state, budget, searchStats) != SolveResult::BUDGET_EXHAUSTED;
+
+		options.propagation = true;
+		SolveResult result = Solver(options).solve(propagated, budget, propagationStats);
+
+		if (searched && result != SolveResult::BUDGET_EXHAUSTED)
+		{
+			report.puzzles++;
+			report.withoutBranching += result == SolveResult::SOLVED && propagationStats.nodes == 0 ? 1 : 0;
+			report.searchNodes += searchStats.nodes;
+			report.propagationNodes += propagationStats.nodes;
+		}
+	}
+
+	long long getArgument(int argc, char* argv[], const char* name, long long defaultValue)
+	{
+		for (int i = 1; i + 1 < argc; i++)
+		{
+			if (strcmp(argv[i], name) == 0)
+			{
+				return atoll(argv[i + 1]);
+			}
+		}
+
+		return defaultValue;
+	}
+
+	std::string getText(int argc, char* argv[], const char* name)
+	{
+		for (int i = 1; i + 1 < argc; i++)
+		{
+			if (strcmp(argv[i], name) == 0)
+			{
+				return argv[i + 1];
+			}
+		}
+
+		return "";
+	}
+
+	bool hasFlag(int argc, char* argv[], const char* name)
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			if (strcmp(argv[i], name) == 0)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void addGenerated(std::vector<std::vector<int>>& puzzles, int count, std::uint64_t seed)
+	{
+		PuzzleGenerator generator(seed);
+
+		for (int i = 0; i < count; i++)
+		{
+			std::vector<int> grid(81);
+			std::vector<int> puzzle(81);
+
+			generator.generateGrid(grid.data());
+			generator.removeClues(grid.data(), puzzle.data(), 17);
+			puzzles.push_back(puzzle);
+
+			// The same puzzle with few clues less has usually more solutions
+			for (int cell = (i * 7) % 81, removed = 0; removed < 3; cell = (cell + 29) % 81)
+			{
+				if (puzzle[cell] != 0)
+				{
+					puzzle[cell] = 0;
+					removed++;
+				}
+			}
+
+			puzzles.push_back(puzzle);
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	std::vector<std::vector<int>> puzzles;
+	std::string corpus = getText(argc, argv, "--corpus");
+	std::string baselineFile = getText(argc, argv, "--baseline");
+	std::string writtenBaseline = getText(argc, argv, "--write-baseline");
+	std::string slowdownText = getText(argc, argv, "--max-slowdown");
+	double maxSlowdown = slowdownText.empty() ? 1.5 : atof(slowdownText.c_str());
+	long long timeout = getArgument(argc, argv, "--timeout-ms", 2000LL);
+	bool passed = true;
+
+	if (!corpus.empty())
+	{
+		std::ifstream file(corpus);
+		std::string line;
+
+		if (!file.is_open())
+		{
+			std::cerr << "Couldn't open " << corpus << std::endl;
+			return 1;
+		}
+
+		while (std::getline(file, line))
+		{
+			std::vector<int> board(81);
+			searchState state;
+
+			// Conflicting givens would only make every engine search the whole tree
+			if (PuzzleFormat::parse(line, board.data()) && state.load(board.data()))
+			{
+				puzzles.push_back(board);
+			}
+		}
+	}
+
+	addGenerated(puzzles, static_cast<int>(getArgument(argc, argv, "--generated", 50LL)),
+		static_cast<std::uint64_t>(getArgument(argc, argv, "--seed", 12345LL)));
+
+	std::vector<engine> engines = getEngines();
+	propagationReport propagation;
+
+	for (const auto& puzzle : puzzles)
+	{
+		reference expected = getReference(puzzle.data());
+		if (!expected.known)
+		{
+			continue;
+		}
+
+		if (expected.count > 0 && !isValidSolution(puzzle.data(), expected.solution))
+		{
+			std::cout << "WRONG constexpr reference: invalid solution" << std::endl
+				<< "  puzzle  " << PuzzleFormat::toLine(puzzle.data()) << std::endl;
+			passed = false;
+			continue;
+		}
+
+		addPropagation(propagation, puzzle.data(), timeout);
+
+		for (auto& solver : engines)
+		{
+			solveBudget budget;
+			budget.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+
+			auto start = std::chrono::steady_clock::now();
+			engineAnswer answer = solver.run(puzzle.data(), budget);
+			long long microseconds = std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::steady_clock::now() - start).count();
+			solver.microseconds += answer.microseconds >= 0 ? answer.microseconds : microseconds;
+			solver.puzzles++;
+
+			if (answer.result == SolveResult::BUDGET_EXHAUSTED)
+			{
+				solver.exhausted++;
+				continue;
+			}
+
+			std::string mistake = check(puzzle.data(), expected, answer);
+			if (mistake.empty())
+			{
+				continue;
+			}
+
+			std::vector<int> reproducer = puzzle;
+			shrink(solver, reproducer.data(), timeout);
+
+			std::cout << "WRONG " << solver.name << ": " << mistake << std::endl
+				<< "  puzzle  " << PuzzleFormat::toLine(puzzle.data()) << std::endl
+				<< "  shrunk  " << PuzzleFormat::toLine(reproducer.data()) << " ("
+				<< findMistake(solver, reproducer.data(), getReference(reproducer.data()), timeout) << ")" << std::endl;
+			solver.wrong++;
+			passed = false;
+		}
+	}
+
+	for (const auto& puzzle : VARIANT_PUZZLES)
+	{
+		std::string mistake = checkVariant(puzzle, timeout);
+		if (!mistake.empty())
+		{
+			std::cout << "WRONG variant " << puzzle.name << ": " << mistake << std::endl;
+			passed = false;
+		}
+	}
+
+	if (hasFlag(argc, argv, "--full-band"))
+	{
+		std::string mistake = checkFullBand();
+		if (!mistake.empty())
+		{
+			std::cout << "WRONG full band: " << mistake << std::endl;
+			passed = false;
+		}
+	}
+
+	std::map<std::string, double> baseline;
+	if (!baselineFile.empty())
+	{
+		std::ifstream file(baselineFile);
+		std::string name;
+		double microseconds;
+
+		if (!file.is_open())
+		{
+			std::cerr << "Couldn't open " << baselineFile << std::endl;
+			return 1;
+		}
+
+		while (file >> name >> microseconds)
+		{
+			baseline[name] = microseconds;
+		}
+	}
+
+	std::ofstream written;
+	if (!writtenBaseline.empty())
+	{
+		written.open(writtenBaseline);
+	}
+
+	for (const auto& solver : engines)
+	{
+		double perPuzzle = solver.puzzles > 0 ? static_cast<double>(solver.microseconds) / solver.puzzles : 0;
+		auto known = baseline.find(solver.name);
+
+		std::cout << solver.name << ": " << solver.puzzles << " puzzles, " << solver.wrong << " wrong, "
+			<< solver.exhausted << " out of budget, " << perPuzzle << " us per puzzle";
+
+		if (known != baseline.end())
+		{
+			double slowdown = known->second > 0 ? perPuzzle / known->second : 1;
+			std::cout << ", " << slowdown << "x baseline";
+
+			if (slowdown > maxSlowdown)
+			{
+				std::cout << " REGRESSION";
+				passed = false;
+			}
+		}
+
+		std::cout << std::endl;
+
+		if (written.is_open())
+		{
+			written << solver.name << " " << perPuzzle << "\n";
+		}
+	}
+
+	std::cout << "Solved without branching: " << propagation.withoutBranching << " of " << propagation.puzzles << " puzzles ("
+		<< (propagation.puzzles > 0 ? 100.0 * propagation.withoutBranching / propagation.puzzles : 0) << " %), min-candidates nodes "
+		<< propagation.searchNodes << " without propagation, " << propagation.propagationNodes << " with it" << std::endl;
+	std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+	return passed ? 0 : 1;
+}
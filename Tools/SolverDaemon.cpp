@@ -0,0 +1,328 @@
+/*
+	Solving daemon for Linux, listens on Unix domain socket and
+	answers one line per request in the order of requests
+
+	Request:  puzzle as 81 characters or "[row,column]:value" entries,
+	          optionally followed by variant rules separated by ';',
+	          e.g. "<81 characters>;diagonal;cage 10 [0,0] [0,1]"
+	Reply:    SOLVED <81 characters> nodes=N backtracks=N us=N
+	          UNSOLVABLE - nodes=N backtracks=N us=N
+	          BUDGET_EXHAUSTED - nodes=N backtracks=N us=N
+	          ERROR invalid puzzle
+	          ERROR line too long
+	          ERROR too many connections
+
+	Usage: SolverDaemon [--socket path] [--workers n] [--queue-depth n]
+	                    [--batch n] [--batch-delay-us n] [--max-nodes n]
+	                    [--timeout-ms n] [--max-connections n]
+
+	Lines longer than 4 KiB close the connection after the error, so
+	a client can't make the daemon buffer unlimited data, and
+	connections above the limit are refused.
+*/
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "../PuzzleFormat.h"
+#include "../SolverService.h"
+
+namespace
+{
+	// Represents listening socket, it's closed by signal to stop accepting
+	volatile int listenFd = -1;
+
+	// Longest accepted request line without the newline
+	const size_t MAX_LINE_LENGTH = 4096;
+
+	// Represents open connections, they are shut down when daemon stops
+	std::set<int> connections;
+	std::mutex connectionsMutex;
+	std::condition_variable connectionsClosed;
+
+	// Represents reply waiting to be written to the connection
+	struct pendingReply
+	{
+		bool valid;
+		// Error written instead of the reply if the request isn't valid
+		const char* error;
+		bool last;
+		std::future<serviceReply> reply;
+	};
+
+	// Represents replies of one connection in the order of requests
+	struct connectionQueue
+	{
+		std::deque<pendingReply> replies;
+		std::mutex mutex;
+		std::condition_variable ready;
+	};
+
+	void onSignal(int)
+	{
+		int fd = listenFd;
+		listenFd = -1;
+		close(fd);
+	}
+
+	bool writeAll(int fd, const std::string& text)
+	{
+		size_t written = 0;
+
+		while (written < text.size())
+		{
+			ssize_t count = write(fd, text.data() + written, text.size() - written);
+			if (count <= 0)
+			{
+				return false;
+			}
+
+			written += static_cast<size_t>(count);
+		}
+
+		return true;
+	}
+
+	const char* getResultName(SolveResult result)
+	{
+		switch (result)
+		{
+		case SolveResult::SOLVED:
+			return "SOLVED";
+		case SolveResult::UNSOLVABLE:
+			return "UNSOLVABLE";
+		default:
+			return "BUDGET_EXHAUSTED";
+		}
+	}
+
+	std::string formatReply(const serviceReply& reply)
+	{
+		std::string text = getResultName(reply.result);
+
+		text += " ";
+		text += reply.result == SolveResult::SOLVED ? PuzzleFormat::toLine(reply.board) : "-";
+		text += " nodes=" + std::to_string(reply.stats.nodes);
+		text += " backtracks=" + std::to_string(reply.stats.backtracks);
+		text += " us=" + std::to_string(reply.stats.elapsedMicroseconds);
+		text += "\n";
+
+		return text;
+	}
+
+	void writeReplies(int fd, connectionQueue* queue)
+	{
+		bool connected = true;
+
+		while (true)
+		{
+			pendingReply pending;
+			{
+				std::unique_lock<std::mutex> lock(queue->mutex);
+				queue->ready.wait(lock, [queue] { return !queue->replies.empty(); });
+				pending = std::move(queue->replies.front());
+				queue->replies.pop_front();
+			}
+
+			if (pending.last)
+			{
+				return;
+			}
+
+			std::string text = pending.valid ? formatReply(pending.reply.get()) : pending.error;
+			connected = connected && writeAll(fd, text);
+		}
+	}
+
+	void pushReply(connectionQueue& queue, pendingReply pending)
+	{
+		{
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			queue.replies.push_back(std::move(pending));
+		}
+
+		queue.ready.notify_one();
+	}
+
+	void handleConnection(int fd, SolverService* service)
+	{
+		connectionQueue queue;
+		std::thread writer(writeReplies, fd, &queue);
+		std::string buffer;
+		char chunk[4096];
+		ssize_t count;
+		bool overflow = false;
+
+		while (!overflow && (count = read(fd, chunk, sizeof(chunk))) > 0)
+		{
+			buffer.append(chunk, static_cast<size_t>(count));
+
+			size_t end;
+			while ((end = buffer.find('\n')) != std::string::npos)
+			{
+				std::string line = buffer.substr(0, end);
+				int board[81];
+				PuzzleRules rules;
+				buffer.erase(0, end + 1);
+
+				if (line.find_first_not_of(" \t\r") == std::string::npos)
+				{
+					continue;
+				}
+
+				std::replace(line.begin(), line.end(), ';', '\n');
+
+				pendingReply pending{ PuzzleFormat::parse(line, board, rules), "ERROR invalid puzzle\n", false, std::future<serviceReply>() };
+				if (pending.valid)
+				{
+					pending.reply = service->submit(board, &rules);
+				}
+
+				pushReply(queue, std::move(pending));
+			}
+
+			if (buffer.size() > MAX_LINE_LENGTH)
+			{
+				pushReply(queue, pendingReply{ false, "ERROR line too long\n", false, std::future<serviceReply>() });
+				overflow = true;
+			}
+		}
+
+		pushReply(queue, pendingReply{ false, "", true, std::future<serviceReply>() });
+		writer.join();
+
+		std::lock_guard<std::mutex> lock(connectionsMutex);
+		connections.erase(fd);
+		close(fd);
+		connectionsClosed.notify_all();
+	}
+
+	long long getArgument(int argc, char* argv[], const char* name, long long defaultValue)
+	{
+		for (int i = 1; i + 1 < argc; i++)
+		{
+			if (strcmp(argv[i], name) == 0)
+			{
+				return atoll(argv[i + 1]);
+			}
+		}
+
+		return defaultValue;
+	}
+
+	std::string getArgument(int argc, char* argv[], const char* name, const std::string& defaultValue)
+	{
+		for (int i = 1; i + 1 < argc; i++)
+		{
+			if (strcmp(argv[i], name) == 0)
+			{
+				return argv[i + 1];
+			}
+		}
+
+		return defaultValue;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	serviceSettings settings;
+	std::string path = getArgument(argc, argv, "--socket", std::string("/tmp/sudoku.sock"));
+
+	settings.workers = static_cast<int>(getArgument(argc, argv, "--workers",
+		static_cast<long long>(std::thread::hardware_concurrency())));
+	settings.queueDepth = static_cast<int>(getArgument(argc, argv, "--queue-depth", settings.queueDepth));
+	settings.batchSize = static_cast<int>(getArgument(argc, argv, "--batch", settings.batchSize));
+	settings.batchDelay = std::chrono::microseconds(getArgument(argc, argv, "--batch-delay-us", 0LL));
+	settings.maxNodes = getArgument(argc, argv, "--max-nodes", settings.maxNodes);
+	settings.timeout = std::chrono::milliseconds(getArgument(argc, argv, "--timeout-ms",
+		static_cast<long long>(settings.timeout.count())));
+	size_t maxConnections = static_cast<size_t>(getArgument(argc, argv, "--max-connections", 256LL));
+
+	sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+
+	if (path.size() >= sizeof(address.sun_path))
+	{
+		std::cerr << "Socket path is too long" << std::endl;
+		return 1;
+	}
+
+	strcpy(address.sun_path, path.c_str());
+	listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+	unlink(path.c_str());
+
+	if (listenFd < 0 ||
+		bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+		listen(listenFd, 128) != 0)
+	{
+		std::cerr << "Couldn't listen on " << path << ": " << strerror(errno) << std::endl;
+		return 1;
+	}
+
+	// Without SA_RESTART the signal interrupts blocking accept
+	struct sigaction action;
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = onSignal;
+	sigaction(SIGINT, &action, nullptr);
+	sigaction(SIGTERM, &action, nullptr);
+	signal(SIGPIPE, SIG_IGN);
+
+	SolverService service(settings);
+	std::cout << "Listening on " << path << " with " << settings.workers << " workers" << std::endl;
+
+	while (true)
+	{
+		int fd = accept(listenFd, nullptr, nullptr);
+		if (fd < 0)
+		{
+			if (errno == EINTR && listenFd >= 0)
+			{
+				continue;
+			}
+
+			break;
+		}
+
+		std::lock_guard<std::mutex> lock(connectionsMutex);
+		if (connections.size() >= maxConnections)
+		{
+			writeAll(fd, "ERROR too many connections\n");
+			close(fd);
+			continue;
+		}
+
+		connections.insert(fd);
+		std::thread(handleConnection, fd, &service).detach();
+	}
+
+	service.stop();
+	{
+		std::unique_lock<std::mutex> lock(connectionsMutex);
+		for (int fd : connections)
+		{
+			shutdown(fd, SHUT_RDWR);
+		}
+
+		connectionsClosed.wait(lock, [] { return connections.empty(); });
+	}
+
+	unlink(path.c_str());
+	std::cout << "Solved " << service.getRequestCount() << " requests in "
+		<< service.getBatchCount() << " batches" << std::endl;
+
+	return 0;
+}
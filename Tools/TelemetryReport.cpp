@@ -0,0 +1,144 @@
+/*
+	Aggregates telemetry of game sessions into percentiles
+
+	Usage: TelemetryReport <file> [file ...]
+
+	Files are telemetry.bin written by the game and its rotated
+	copies, sessions split between files are joined by identifier.
+	Time per move is the time since the previous move or the start
+	of the session, a move is conflicting if it found any same
+	number, time to win is measured from the start of the session.
+*/
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "../Telemetry.h"
+
+namespace
+{
+	// Represents totals of one session
+	struct sessionSummary
+	{
+		long long moves = 0;
+		long long conflicts = 0;
+		long long notes = 0;
+		// Microseconds to win, -1 if the game wasn't won
+		long long winTime = -1;
+	};
+
+	// Get value below which the given percent of sorted values lies
+	long long getPercentile(const std::vector<long long>& sorted, double percent)
+	{
+		if (sorted.empty())
+		{
+			return 0;
+		}
+
+		size_t index = static_cast<size_t>(percent / 100.0 * (sorted.size() - 1) + 0.5);
+		return sorted[index];
+	}
+
+	void printPercentiles(const char* name, std::vector<long long>& values, double scale, const char* unit)
+	{
+		std::sort(values.begin(), values.end());
+		std::cout << name << " (" << values.size() << "):";
+
+		if (values.empty())
+		{
+			std::cout << " no data" << std::endl;
+			return;
+		}
+
+		const double percents[] = { 50, 90, 99 };
+		for (double percent : percents)
+		{
+			std::cout << " p" << percent << " " << getPercentile(values, percent) / scale << unit;
+		}
+
+		std::cout << " max " << values.back() / scale << unit << std::endl;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: TelemetryReport <file> [file ...]" << std::endl;
+		return 1;
+	}
+
+	std::vector<telemetryEvent> events;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (!Telemetry::read(argv[i], events))
+		{
+			std::cerr << "Skipping " << argv[i] << ", it isn't telemetry file" << std::endl;
+		}
+	}
+
+	std::map<std::uint64_t, sessionSummary> sessions;
+	std::vector<long long> moveTimes;
+
+	for (const telemetryEvent& event : events)
+	{
+		sessionSummary& session = sessions[event.session];
+
+		switch (event.kind)
+		{
+		case TelemetryKind::MOVE:
+			session.moves++;
+			session.conflicts += event.conflicts > 0 ? 1 : 0;
+			moveTimes.push_back(event.duration);
+			break;
+		case TelemetryKind::NOTE:
+			session.notes++;
+			break;
+		case TelemetryKind::WIN:
+			session.winTime = static_cast<long long>(event.time);
+			break;
+		default:
+			break;
+		}
+	}
+
+	long long moves = 0;
+	long long conflicts = 0;
+	long long notes = 0;
+	std::vector<long long> winTimes;
+	std::vector<long long> movesPerSession;
+	std::vector<long long> conflictRates;
+
+	for (const auto& entry : sessions)
+	{
+		const sessionSummary& session = entry.second;
+
+		moves += session.moves;
+		conflicts += session.conflicts;
+		notes += session.notes;
+		movesPerSession.push_back(session.moves);
+
+		if (session.moves > 0)
+		{
+			conflictRates.push_back(session.conflicts * 1000 / session.moves);
+		}
+
+		if (session.winTime >= 0)
+		{
+			winTimes.push_back(session.winTime);
+		}
+	}
+
+	std::cout << events.size() << " events, " << sessions.size() << " sessions, "
+		<< winTimes.size() << " won, " << moves << " moves, " << notes << " notes" << std::endl;
+	std::cout << "Conflict rate: " << (moves > 0 ? 100.0 * conflicts / moves : 0.0) << " % of moves" << std::endl;
+	printPercentiles("Time per move", moveTimes, 1000.0, " ms");
+	printPercentiles("Conflict rate per session", conflictRates, 10.0, " %");
+	printPercentiles("Moves per session", movesPerSession, 1.0, "");
+	printPercentiles("Time to win", winTimes, 1000000.0, " s");
+
+	return 0;
+}
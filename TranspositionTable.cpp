@@ -0,0 +1,71 @@
+#include "TranspositionTable.h"
+
+const size_t TranspositionTable::DEFAULT_CAPACITY = 1 << 16;
+
+
+TranspositionTable::TranspositionTable(size_t capacity)
+{
+	size_t size = 2;
+
+	while (size < capacity)
+	{
+		size *= 2;
+	}
+
+	slots_.reset(new tableSlot[size]);
+	mask_ = size - 1;
+	clear();
+}
+
+
+TranspositionTable::~TranspositionTable()
+{
+}
+
+
+bool TranspositionTable::store(std::uint64_t hash, std::uint64_t check)
+{
+	tableSlot& slot = slots_[hash & mask_];
+	std::uint64_t replaced = slot.hash.exchange(hash, std::memory_order_relaxed);
+
+	slot.check.store(hash ^ check, std::memory_order_relaxed);
+	return replaced != 0 && replaced != hash;
+}
+
+
+bool TranspositionTable::contains(std::uint64_t hash, std::uint64_t check) const
+{
+	const tableSlot& slot = slots_[hash & mask_];
+
+	return hash != 0 && slot.hash.load(std::memory_order_relaxed) == hash &&
+		(slot.check.load(std::memory_order_relaxed) ^ hash) == check;
+}
+
+
+void TranspositionTable::clear()
+{
+	for (size_t i = 0; i <= mask_; i++)
+	{
+		slots_[i].hash.store(0, std::memory_order_relaxed);
+		slots_[i].check.store(0, std::memory_order_relaxed);
+	}
+}
+
+
+size_t TranspositionTable::getUsedCount() const
+{
+	size_t count = 0;
+
+	for (size_t i = 0; i <= mask_; i++)
+	{
+		count += slots_[i].hash.load(std::memory_order_relaxed) != 0 ? 1 : 0;
+	}
+
+	return count;
+}
+
+
+size_t TranspositionTable::getCapacity() const
+{
+	return mask_ + 1;
+}
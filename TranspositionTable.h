@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+
+/*
+	Represents lossy table of Zobrist hashes of states proven to have
+	no solution, every hash has one slot where it replaces older hash
+	so the table never grows, it can be shared by searches on many
+	threads because a state without solution never gets one, every
+	hash is stored with independent check word so two states collide
+	only if both 64-bit words are equal
+*/
+class TranspositionTable
+{
+public:
+	/*
+		Creates table, the capacity is rounded up to power of two
+
+		@param capacity Minimal count of slots
+	*/
+	TranspositionTable(size_t capacity);
+	~TranspositionTable();
+
+	/*
+		Remembers state without solution
+
+		@param hash Zobrist hash of the state
+		@param check Check word of the state independent of the hash
+		@return if other state was replaced
+	*/
+	bool store(std::uint64_t hash, std::uint64_t check);
+
+	/*
+		Checks if the state is known to have no solution
+
+		@param hash Zobrist hash of the state
+		@param check Check word of the state independent of the hash
+		@return if the state is in the table
+	*/
+	bool contains(std::uint64_t hash, std::uint64_t check) const;
+
+	/*
+		Forgets every state
+	*/
+	void clear();
+
+	/*
+		Get count of occupied slots, it walks the whole table
+
+		@return count of occupied slots
+	*/
+	size_t getUsedCount() const;
+
+	/*
+		Get count of slots
+
+		@return count of slots
+	*/
+	size_t getCapacity() const;
+public:
+	const static size_t DEFAULT_CAPACITY;
+private:
+	// Represents one remembered state, the check is stored xored with the
+	// hash so slot torn by two concurrent stores never matches
+	struct tableSlot
+	{
+		std::atomic<std::uint64_t> hash;
+		std::atomic<std::uint64_t> check;
+	};
+private:
+	// Represents slots, hash 0 marks free slot
+	std::unique_ptr<tableSlot[]> slots_;
+	// Represents capacity - 1
+	size_t mask_;
+};
@@ -0,0 +1,233 @@
+#include "VariantSolver.h"
+
+
+bool variantState::load(const PuzzleRules& puzzleRules, const int* board)
+{
+	bool valid = true;
+
+	rules = &puzzleRules;
+	for (int unit = 0; unit < rules->getUnitCount(); unit++)
+	{
+		unitMask[unit] = 0;
+		unitSum[unit] = 0;
+	}
+
+	emptyCount = 81;
+	for (int cell = 0; cell < 81; cell++)
+	{
+		int value = board[cell];
+		values[cell] = 0;
+
+		if (value < 1 || value > 9)
+		{
+			continue;
+		}
+
+		if (!(getCandidates(cell) & (1 << value)))
+		{
+			valid = false;
+		}
+
+		place(cell, value);
+	}
+
+	return valid;
+}
+
+
+void variantState::store(int* board) const
+{
+	for (int cell = 0; cell < 81; cell++)
+	{
+		board[cell] = values[cell];
+	}
+}
+
+
+std::uint16_t variantState::getCandidates(int cell) const
+{
+	const std::uint8_t* units = rules->getUnitsOfCell(cell);
+	std::uint16_t used = 0;
+
+	for (int i = rules->getUnitCountOfCell(cell) - 1; i >= 0; i--)
+	{
+		used |= unitMask[units[i]];
+	}
+
+	std::uint16_t candidates = rules->getCellMask(cell) & ~used;
+	int cage = rules->getCageOfCell(cell);
+
+	if (cage >= 0)
+	{
+		candidates &= rules->getCageCandidates(cage, unitMask[cage], unitSum[cage]);
+	}
+
+	return candidates;
+}
+
+
+void variantState::place(int cell, int value)
+{
+	const std::uint8_t* units = rules->getUnitsOfCell(cell);
+	std::uint16_t bit = static_cast<std::uint16_t>(1 << value);
+
+	values[cell] = static_cast<std::uint8_t>(value);
+	for (int i = rules->getUnitCountOfCell(cell) - 1; i >= 0; i--)
+	{
+		unitMask[units[i]] |= bit;
+		unitSum[units[i]] = static_cast<std::uint8_t>(unitSum[units[i]] + value);
+	}
+
+	emptyCount--;
+}
+
+
+void variantState::undo(int cell)
+{
+	const std::uint8_t* units = rules->getUnitsOfCell(cell);
+	int value = values[cell];
+	std::uint16_t bit = static_cast<std::uint16_t>(1 << value);
+
+	values[cell] = 0;
+	for (int i = rules->getUnitCountOfCell(cell) - 1; i >= 0; i--)
+	{
+		unitMask[units[i]] &= ~bit;
+		unitSum[units[i]] = static_cast<std::uint8_t>(unitSum[units[i]] - value);
+	}
+
+	emptyCount++;
+}
+
+
+SolveResult VariantSolver::solve(variantState& state, const solveBudget& budget, solveStats& stats) const
+{
+	long long count = 0;
+
+	return search(state, 1, count, true, budget, stats);
+}
+
+
+SolveResult VariantSolver::countSolutions(variantState& state, long long limit, long long& count,
+	const solveBudget& budget, solveStats& stats) const
+{
+	return search(state, limit, count, false, budget, stats);
+}
+
+
+int VariantSolver::getNextEmptyCell(const variantState& state) const
+{
+	int best = -1;
+	int bestCount = 10;
+
+	for (int cell = 0; cell < 81; cell++)
+	{
+		if (state.values[cell] != 0)
+		{
+			continue;
+		}
+
+		int count = countBits(state.getCandidates(cell));
+		if (count < bestCount)
+		{
+			best = cell;
+			bestCount = count;
+
+			if (count <= 1)
+			{
+				return best;
+			}
+		}
+	}
+
+	return best;
+}
+
+
+SolveResult VariantSolver::search(variantState& state, long long limit, long long& count, bool keepSolution,
+	const solveBudget& budget, solveStats& stats) const
+{
+	auto start = std::chrono::steady_clock::now();
+	SolveResult result = SolveResult::UNSOLVABLE;
+	int firstCell = getNextEmptyCell(state);
+
+	count = 0;
+	if (firstCell < 0)
+	{
+		count = 1;
+		return SolveResult::SOLVED;
+	}
+
+	SearchArena& arena = SearchArena::local();
+	searchFrame* trail = arena.acquire();
+	int depth = 0;
+	trail[0] = searchFrame{ firstCell, 0, state.getCandidates(firstCell) };
+
+	while (depth >= 0)
+	{
+		searchFrame& frame = trail[depth];
+
+		if (frame.value != 0)
+		{
+			state.undo(frame.cell);
+			frame.value = 0;
+			stats.backtracks++;
+		}
+
+		if (frame.remaining == 0)
+		{
+			depth--;
+			continue;
+		}
+
+		if (Solver::isBudgetExhausted(budget, stats))
+		{
+			result = SolveResult::BUDGET_EXHAUSTED;
+			break;
+		}
+
+		int value = 1;
+		while (!(frame.remaining & (1 << value)))
+		{
+			value++;
+		}
+
+		frame.remaining &= ~(1 << value);
+		state.place(frame.cell, value);
+		frame.value = value;
+		stats.nodes++;
+
+		int nextCell = getNextEmptyCell(state);
+		if (nextCell < 0)
+		{
+			result = SolveResult::SOLVED;
+
+			// Counting continues with the next candidate of the last cell
+			if (++count < limit)
+			{
+				continue;
+			}
+
+			break;
+		}
+
+		depth++;
+		trail[depth] = searchFrame{ nextCell, 0, state.getCandidates(nextCell) };
+	}
+
+	if (result != SolveResult::SOLVED || !keepSolution)
+	{
+		for (; depth >= 0; depth--)
+		{
+			if (trail[depth].value != 0)
+			{
+				state.undo(trail[depth].cell);
+			}
+		}
+	}
+
+	arena.release(trail);
+	stats.elapsedMicroseconds += std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now() - start).count();
+
+	return result;
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <cstdint>
+#include "PuzzleRules.h"
+#include "Solver.h"
+
+
+/*
+	Represents state of the board during search of puzzle with
+	any rules, the rules aren't owned and have to outlive the state
+*/
+struct variantState
+{
+	// Compiled rules of the puzzle
+	const PuzzleRules* rules;
+	// Values of cells in row-major order, 0 means empty cell
+	std::uint8_t values[81];
+	// Bitmasks of used values in units, bit 1 represents value 1
+	std::uint16_t unitMask[PuzzleRules::MAX_UNITS];
+	// Sums of placed values in units
+	std::uint8_t unitSum[PuzzleRules::MAX_UNITS];
+	// Count of empty cells
+	int emptyCount;
+
+	/*
+		Loads board in row-major order
+
+		@param puzzleRules Rules of the puzzle
+		@param board Board with values 0..9
+		@return if the given numbers don't break the rules
+	*/
+	bool load(const PuzzleRules& puzzleRules, const int* board);
+
+	/*
+		Stores board in row-major order
+
+		@param board Board where the values are written
+	*/
+	void store(int* board) const;
+
+	/*
+		Get bitmask of values that can be placed into cell
+
+		@param cell Index of the cell
+		@return Bitmask of candidates
+	*/
+	std::uint16_t getCandidates(int cell) const;
+
+	/*
+		Places value into empty cell without checking rules
+
+		@param cell Index of the cell
+		@param value Placed value
+	*/
+	void place(int cell, int value);
+
+	/*
+		Removes value from cell
+
+		@param cell Index of the cell
+	*/
+	void undo(int cell);
+};
+
+
+/*
+	Represents iterative backtracking search of puzzles with
+	variant rules, cells with the fewest candidates go first
+*/
+class VariantSolver
+{
+public:
+	/*
+		Finds solution of the state within given limits, if the
+		solution isn't found the state is restored
+
+		@param state State with loaded problem
+		@param budget Limits of the solving
+		@param stats Statistics gathered so far
+		@return Result of the solving
+	*/
+	SolveResult solve(variantState& state, const solveBudget& budget, solveStats& stats) const;
+
+	/*
+		Counts solutions up to the limit, the state is restored
+
+		@param state State with loaded problem
+		@param limit Count where the counting stops
+		@param count Count of found solutions
+		@param budget Limits of the solving
+		@param stats Statistics gathered so far
+		@return Result of the enumeration
+	*/
+	SolveResult countSolutions(variantState& state, long long limit, long long& count,
+		const solveBudget& budget, solveStats& stats) const;
+private:
+	/*
+		Finds empty cell with the fewest candidates
+
+		@param state Searched state
+		@return Index of the cell or -1 if the board is full
+	*/
+	int getNextEmptyCell(const variantState& state) const;
+
+	/*
+		Searches the state until limit of solutions is found
+
+		@param state State with loaded problem
+		@param limit Count of solutions where the search stops
+		@param count Count of found solutions
+		@param keepSolution Decides if the last solution stays in the state
+		@param budget Limits of the solving
+		@param stats Statistics gathered so far
+		@return Result of the search
+	*/
+	SolveResult search(variantState& state, long long limit, long long& count, bool keepSolution,
+		const solveBudget& budget, solveStats& stats) const;
+};
@@ -0,0 +1,60 @@
+#include "Zobrist.h"
+
+const std::uint64_t Zobrist::SEED = 0x5D0C0B0A2D5EED01ULL;
+
+namespace
+{
+	// Represents keys generated by splitmix64 so they are the same in every build
+	struct keyTable
+	{
+		std::uint64_t keys[81][10];
+
+		keyTable()
+		{
+			std::uint64_t state = Zobrist::SEED;
+
+			for (int cell = 0; cell < 81; cell++)
+			{
+				keys[cell][0] = 0;
+
+				for (int value = 1; value < 10; value++)
+				{
+					std::uint64_t key = (state += 0x9E3779B97F4A7C15ULL);
+					key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+					key = (key ^ (key >> 27)) * 0x94D049BB133111EBULL;
+					keys[cell][value] = key ^ (key >> 31);
+				}
+			}
+		}
+	};
+
+	const keyTable TABLE;
+}
+
+
+std::uint64_t Zobrist::getKey(int cell, int value)
+{
+	return TABLE.keys[cell][value];
+}
+
+
+std::uint64_t Zobrist::getHash(const int* board)
+{
+	std::uint64_t hash = 0;
+
+	for (int cell = 0; cell < 81; cell++)
+	{
+		if (board[cell] >= 1 && board[cell] <= 9)
+		{
+			hash ^= TABLE.keys[cell][board[cell]];
+		}
+	}
+
+	return hash;
+}
+
+
+std::uint64_t Zobrist::update(std::uint64_t hash, int cell, int oldValue, int newValue)
+{
+	return hash ^ TABLE.keys[cell][oldValue] ^ TABLE.keys[cell][newValue];
+}
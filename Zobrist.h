@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+
+
+/*
+	Represents 64-bit Zobrist hashing of boards, hash of the board
+	is XOR of keys of its filled cells so placing or removing one
+	value updates the hash in O(1)
+*/
+class Zobrist
+{
+public:
+	/*
+		Get key of the value in the cell, key of empty cell is 0
+
+		@param cell Index of the cell
+		@param value Value 0..9
+		@return Key of the value in the cell
+	*/
+	static std::uint64_t getKey(int cell, int value);
+
+	/*
+		Computes hash of the whole board
+
+		@param board Board in row-major order
+		@return Hash of the board
+	*/
+	static std::uint64_t getHash(const int* board);
+
+	/*
+		Get new hash after the value of the cell is changed
+
+		@param hash Hash before the change
+		@param cell Index of the cell
+		@param oldValue Value before the change
+		@param newValue Value after the change
+		@return Hash after the change
+	*/
+	static std::uint64_t update(std::uint64_t hash, int cell, int oldValue, int newValue);
+public:
+	const static std::uint64_t SEED;
+};